@@ -1,5 +1,10 @@
+#include <string>
+
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <EASTL/string.h>
+
 #include <bpt/bpt.hpp>
 
 #include <GA.hpp>
@@ -11,12 +16,255 @@ using namespace bpt;
 
 void createGABindings(py::module &m)
 {
+  py::class_<GAParameters>(m, "GAParameters")
+    .def(py::init())
+    .def(py::init([](float mutationRate,
+                     int populationSize,
+                     int numGenerations,
+                     int tournamentSize,
+                     int numPrevGenOffsprings,
+                     bool isLocalSearchEnabled,
+                     SelectionType selectionType) {
+      return new GAParameters{
+        mutationRate,
+        populationSize,
+        numGenerations,
+        tournamentSize,
+        numPrevGenOffsprings,
+        isLocalSearchEnabled,
+        selectionType
+      };
+    }))
+    .def_readwrite("mutationRate", &GAParameters::mutationRate)
+    .def_readwrite("populationSize", &GAParameters::populationSize)
+    .def_readwrite("numGenerations", &GAParameters::numGenerations)
+    .def_readwrite("tournamentSize", &GAParameters::tournamentSize)
+    .def_readwrite("numPrevGenOffsprings",
+                   &GAParameters::numPrevGenOffsprings)
+    .def_readwrite("isLocalSearchEnabled",
+                   &GAParameters::isLocalSearchEnabled)
+    .def_readwrite("selectionType", &GAParameters::selectionType);
+
+  py::class_<Island>(m, "Island")
+    .def(py::init([](int islandIndex,
+                     const py::list& addresses,
+                     int numMigrants,
+                     int migrationInterval) {
+      eastl::vector<eastl::string> islandAddresses;
+      for (const py::handle& address : addresses) {
+        islandAddresses.push_back(
+            eastl::string{ address.cast<std::string>().c_str() });
+      }
+
+      return new Island{
+        islandIndex,
+        islandAddresses,
+        numMigrants,
+        migrationInterval
+      };
+    }))
+    .def("open", &Island::open)
+    .def("close", &Island::close, py::call_guard<py::gil_scoped_release>())
+    .def("getIslandIndex", &Island::getIslandIndex)
+    .def("getNumIslands", &Island::getNumIslands)
+    .def("getNumMigrants", &Island::getNumMigrants)
+    .def("getMigrationInterval", &Island::getMigrationInterval)
+    .def("isCoordinator", &Island::isCoordinator)
+    .def("hasGlobalBestSolution", &Island::hasGlobalBestSolution)
+    .def("getGlobalBestSolution", &Island::getGlobalBestSolution)
+    .def("waitForFinalSolutions",
+         &Island::waitForFinalSolutions,
+         py::call_guard<py::gil_scoped_release>());
+
   py::class_<GA>(m, "GA")
     .def(py::init())
-    .def("generateSolutions", &GA::generateSolutions)
+    .def("generateSolutions",
+         py::overload_cast<const eastl::vector<InputBuilding>&,
+                           const cx::NPolygon&,
+                           const eastl::vector<eastl::vector<float>>&,
+                           eastl::vector<cx::NPolygon>&,
+                           eastl::vector<cx::NPolygon>&,
+                           const float,
+                           const int,
+                           const int,
+                           const int,
+                           const int,
+                           const float,
+                           const float,
+                           const float,
+                           const bool,
+                           const SelectionType>(&GA::generateSolutions))
+    .def("generateSolutions",
+         py::overload_cast<const Problem&, const GAParameters&>(
+             &GA::generateSolutions),
+         py::call_guard<py::gil_scoped_release>())
+    .def("generateSolutions",
+         py::overload_cast<const Problem&,
+                           const GAParameters&,
+                           const eastl::vector<Solution>&>(
+           &GA::generateSolutions),
+         py::call_guard<py::gil_scoped_release>())
+    .def("reoptimizeSolutions",
+         &GA::reoptimizeSolutions,
+         py::call_guard<py::gil_scoped_release>())
+    .def("generateSolutionsInBatch",
+         &GA::generateSolutionsInBatch,
+         py::call_guard<py::gil_scoped_release>())
     .def("getSolutionFitness", &GA::getSolutionFitness)
+    // Scores a (k, n, 3) array of k layouts of the n buildings of the
+    // problem, with each building given as (x, y, rotation). Returns a
+    // length-k array of fitnesses and a length-k feasibility mask.
+    .def("scoreSolutions",
+         [](GA& ga,
+            const Problem& problem,
+            const py::array_t<float,
+                              py::array::c_style
+                              | py::array::forcecast>& layouts,
+            int numThreads) {
+           const int numBuildings = static_cast<int>(
+               problem.inputBuildings.size());
+           if (layouts.ndim() != 3
+               || layouts.shape(1) != numBuildings
+               || layouts.shape(2) != 3) {
+             throw py::value_error(
+                 "layouts must be a (k, n, 3) array, with n being the number "
+                 "of buildings in the problem");
+           }
+
+           const int numLayouts = static_cast<int>(layouts.shape(0));
+           py::array_t<double> fitnesses(numLayouts);
+           py::array_t<bool> feasibilities(numLayouts);
+           auto layoutsView = layouts.unchecked<3>();
+           auto fitnessesView = fitnesses.mutable_unchecked<1>();
+           auto feasibilitiesView = feasibilities.mutable_unchecked<1>();
+
+           {
+             py::gil_scoped_release release;
+
+             eastl::vector<Solution> solutions;
+             solutions.reserve(numLayouts);
+             for (int i = 0; i < numLayouts; i++) {
+               solutions.emplace_back(numBuildings);
+               Solution& solution = solutions.back();
+               for (int j = 0; j < numBuildings; j++) {
+                 solution.setBuildingXPos(j, layoutsView(i, j, 0));
+                 solution.setBuildingYPos(j, layoutsView(i, j, 1));
+                 solution.setBuildingRotation(j, layoutsView(i, j, 2));
+               }
+             }
+
+             eastl::vector<double> solutionFitnesses;
+             eastl::vector<uint8_t> solutionFeasibilities;
+             ga.scoreSolutions(problem,
+                               solutions,
+                               solutionFitnesses,
+                               solutionFeasibilities,
+                               numThreads);
+
+             for (int i = 0; i < numLayouts; i++) {
+               fitnessesView(i) = solutionFitnesses[i];
+               feasibilitiesView(i) = solutionFeasibilities[i] != 0;
+             }
+           }
+
+           return py::make_tuple(fitnesses, feasibilities);
+         },
+         py::arg("problem"),
+         py::arg("layouts"),
+         py::arg("numThreads") = 0)
+    .def("generateParetoFront",
+         py::overload_cast<const eastl::vector<InputBuilding>&,
+                           const cx::NPolygon&,
+                           const eastl::vector<eastl::vector<float>>&,
+                           const eastl::vector<cx::NPolygon>&,
+                           const eastl::vector<cx::NPolygon>&,
+                           const float,
+                           const int,
+                           const int>(&GA::generateParetoFront))
+    .def("generateParetoFront",
+         py::overload_cast<const Problem&,
+                           const float,
+                           const int,
+                           const int>(&GA::generateParetoFront),
+         py::call_guard<py::gil_scoped_release>())
+    .def("getSolutionObjectives", &GA::getSolutionObjectives)
+    .def("getRecentRunParetoFrontObjectives",
+         &GA::getRecentRunParetoFrontObjectives)
     .def("getCurrentRunGenerationNumber", &GA::getCurrentRunGenerationNumber)
+    .def("getCurrentRunProgress", &GA::getCurrentRunProgress)
     .def("getRecentRunAverageFitnesses", &GA::getRecentRunAverageFitnesses)
     .def("getRecentRunBestFitnesses", &GA::getRecentRunBestFitnesses)
-    .def("getRecentRunWorstFitnesses", &GA::getRecentRunWorstFitnesses);
+    .def("getRecentRunWorstFitnesses", &GA::getRecentRunWorstFitnesses)
+    .def("getRecentRunFitnessCacheHitRates",
+         &GA::getRecentRunFitnessCacheHitRates)
+    .def("setFitnessCacheCapacity", &GA::setFitnessCacheCapacity)
+    .def("getFitnessCacheCapacity", &GA::getFitnessCacheCapacity)
+    .def("setReplacementType", &GA::setReplacementType)
+    .def("getReplacementType", &GA::getReplacementType)
+    .def("setGeneEncoding", &GA::setGeneEncoding)
+    .def("getGeneEncoding", &GA::getGeneEncoding)
+    .def("setMutationSelectionType", &GA::setMutationSelectionType)
+    .def("getMutationSelectionType", &GA::getMutationSelectionType)
+    .def("getRecentRunMutationProbabilities",
+         &GA::getRecentRunMutationProbabilities)
+    .def("getRecentRunMutationSeconds", &GA::getRecentRunMutationSeconds)
+    .def("setIsland", &GA::setIsland, py::keep_alive<1, 2>())
+    .def("setConstraintHandlingType", &GA::setConstraintHandlingType)
+    .def("getConstraintHandlingType", &GA::getConstraintHandlingType)
+    .def("setInitializationType", &GA::setInitializationType)
+    .def("getInitializationType", &GA::getInitializationType)
+    .def("setPerfCounterSampling", &GA::setPerfCounterSampling)
+    .def("isPerfCounterSamplingEnabled", &GA::isPerfCounterSamplingEnabled)
+    .def("getRecentRunPerfCounts", &GA::getRecentRunPerfCounts);
+
+  // The engine keeps a reference to the problem, so the problem is kept
+  // alive for as long as the engine is.
+  py::class_<GAEngine>(m, "GAEngine")
+    .def(py::init<const Problem&, const GAParameters&>(),
+         py::keep_alive<1, 2>())
+    .def("getGA", &GAEngine::getGA, py::return_value_policy::reference_internal)
+    .def("initialize",
+         py::overload_cast<>(&GAEngine::initialize),
+         py::call_guard<py::gil_scoped_release>())
+    .def("initialize",
+         py::overload_cast<const eastl::vector<Solution>&>(
+             &GAEngine::initialize),
+         py::call_guard<py::gil_scoped_release>())
+    .def("step",
+         [](GAEngine& engine, int numGenerations) {
+           if (!engine.isInitialized() || engine.isFinished()) {
+             throw py::value_error("the engine has no run going on");
+           }
+
+           if (numGenerations < 0) {
+             throw py::value_error("numGenerations must not be negative");
+           }
+
+           py::gil_scoped_release release;
+           engine.step(numGenerations);
+         })
+    .def("finish",
+         [](GAEngine& engine) {
+           if (!engine.isInitialized() || engine.isFinished()) {
+             throw py::value_error("the engine has no run going on");
+           }
+
+           engine.finish();
+         })
+    .def("isInitialized", &GAEngine::isInitialized)
+    .def("isFinished", &GAEngine::isFinished)
+    .def("getNumGenerationsDone", &GAEngine::getNumGenerationsDone)
+    .def("setMutationRate", &GAEngine::setMutationRate)
+    .def("getMutationRate", &GAEngine::getMutationRate)
+    .def("getParameters", &GAEngine::getParameters)
+    .def("getPopulation", &GAEngine::getPopulation)
+    .def("hasBestSolution", &GAEngine::hasBestSolution)
+    .def("getBestSolution",
+         [](const GAEngine& engine) {
+           if (!engine.hasBestSolution()) {
+             throw py::value_error("the run has no best solution yet");
+           }
+
+           return engine.getBestSolution();
+         });
 }
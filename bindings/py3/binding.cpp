@@ -4,6 +4,8 @@
 #include <ds.hpp>
 #include <enums.hpp>
 #include <GA.hpp>
+#include <io.hpp>
+#include <tracing.hpp>
 
 namespace py = pybind11;
 
@@ -12,6 +14,8 @@ PYBIND11_MODULE(pylibbpt, m)
   createDSBindings(m);
   createEnumBindings(m);
   createGABindings(m);
+  createIOBindings(m);
+  createTracingBindings(m);
 
   // Minimal CoreX functions and data structures libbpt
   // users need.
@@ -1,8 +1,14 @@
+#include <string>
+
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <EASTL/string.h>
+
 #include <bpt/bpt.hpp>
 
 #include <ds.hpp>
+#include <eastl.hpp>
 
 namespace py = pybind11;
 
@@ -30,7 +36,141 @@ void createDSBindings(py::module &m)
     .def("getBuildingYPos", &Solution::getBuildingYPos)
     .def("getBuildingRotation", &Solution::getBuildingRotation)
     .def("getNumBuildings", &Solution::getNumBuildings)
+    .def("isCompact", &Solution::isCompact)
     .def("getFitness", &Solution::getFitness)
     .def("__eq__", &Solution::operator==, py::is_operator())
     .def("__ne__", &Solution::operator!=, py::is_operator());
+
+  py::class_<FlowMatrix>(m, "FlowMatrix")
+    .def(py::init())
+    // Copies an (n, n) array straight into the tiles, without going through
+    // Python lists.
+    .def(py::init([](const py::array_t<float,
+                                       py::array::c_style
+                                       | py::array::forcecast>& flowRates) {
+      if (flowRates.ndim() != 2 || flowRates.shape(0) != flowRates.shape(1)) {
+        throw py::value_error("flowRates must be an (n, n) array");
+      }
+
+      return new FlowMatrix{
+        static_cast<int>(flowRates.shape(0)),
+        flowRates.data()
+      };
+    }))
+    .def(py::init<const eastl::vector<eastl::vector<float>>&>())
+    .def("mapFile", [](FlowMatrix& flowMatrix, const std::string& filePath) {
+      return flowMatrix.mapFile(eastl::string{ filePath.c_str() });
+    })
+    .def("writeFile",
+         [](const FlowMatrix& flowMatrix, const std::string& filePath) {
+      return flowMatrix.writeFile(eastl::string{ filePath.c_str() });
+    })
+    .def("getNumBuildings", &FlowMatrix::getNumBuildings)
+    .def("getNumTiles", &FlowMatrix::getNumTiles)
+    .def("isMapped", &FlowMatrix::isMapped)
+    .def("getFlowRate", &FlowMatrix::getFlowRate);
+
+  py::class_<Problem>(m, "Problem")
+    .def(py::init<const eastl::vector<InputBuilding>&,
+                  const cx::NPolygon&,
+                  const eastl::vector<eastl::vector<float>>&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const float,
+                  const float,
+                  const float>())
+    .def(py::init<const eastl::vector<InputBuilding>&,
+                  const cx::NPolygon&,
+                  const eastl::vector<eastl::vector<float>>&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const float,
+                  const float,
+                  const float,
+                  const eastl::vector<float>&>())
+    .def(py::init<const eastl::vector<InputBuilding>&,
+                  const cx::NPolygon&,
+                  const FlowMatrix&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const eastl::vector<cx::NPolygon>&,
+                  const float,
+                  const float,
+                  const float,
+                  const eastl::vector<float>&>())
+    .def_readonly("inputBuildings", &Problem::inputBuildings)
+    .def_readonly("flowRates", &Problem::flowRates)
+    .def_readonly("floodProneAreaPenalty", &Problem::floodProneAreaPenalty)
+    .def_readonly("landslideProneAreaPenalty",
+                  &Problem::landslideProneAreaPenalty)
+    .def_readonly("buildingDistanceWeight", &Problem::buildingDistanceWeight);
+
+  py::class_<ProblemChange>(m, "ProblemChange")
+    .def(py::init())
+    .def(py::init([](const eastl::vector<int>& removedBuildings,
+                     int numAddedBuildings,
+                     bool areHazardAreasChanged,
+                     bool isSiteChanged) {
+      return new ProblemChange{
+        removedBuildings,
+        numAddedBuildings,
+        areHazardAreasChanged,
+        isSiteChanged
+      };
+    }))
+    .def_readwrite("removedBuildings", &ProblemChange::removedBuildings)
+    .def_readwrite("numAddedBuildings", &ProblemChange::numAddedBuildings)
+    .def_readwrite("areHazardAreasChanged",
+                   &ProblemChange::areHazardAreasChanged)
+    .def_readwrite("isSiteChanged", &ProblemChange::isSiteChanged);
+
+  py::class_<ProblemInstance>(m, "ProblemInstance")
+    .def(py::init())
+    .def_readwrite("inputBuildings", &ProblemInstance::inputBuildings)
+    .def_readwrite("boundingArea", &ProblemInstance::boundingArea)
+    .def_readwrite("flowRates", &ProblemInstance::flowRates)
+    .def_property(
+        "flowMatrixFilePath",
+        [](const ProblemInstance& instance) {
+          return std::string{ instance.flowMatrixFilePath.c_str() };
+        },
+        [](ProblemInstance& instance, const std::string& filePath) {
+          instance.flowMatrixFilePath = eastl::string{ filePath.c_str() };
+        })
+    .def_readwrite("floodProneAreas", &ProblemInstance::floodProneAreas)
+    .def_readwrite("landslideProneAreas",
+                   &ProblemInstance::landslideProneAreas)
+    .def_readwrite("floodProneAreaPenalty",
+                   &ProblemInstance::floodProneAreaPenalty)
+    .def_readwrite("landslideProneAreaPenalty",
+                   &ProblemInstance::landslideProneAreaPenalty)
+    .def_readwrite("buildingDistanceWeight",
+                   &ProblemInstance::buildingDistanceWeight)
+    .def_readwrite("allowedOrientations",
+                   &ProblemInstance::allowedOrientations)
+    .def_readwrite("parameters", &ProblemInstance::parameters);
+
+  py::class_<PerfCounts>(m, "PerfCounts")
+    .def_readonly("cycles", &PerfCounts::cycles)
+    .def_readonly("instructions", &PerfCounts::instructions)
+    .def_readonly("llcMisses", &PerfCounts::llcMisses)
+    .def_readonly("branchMisses", &PerfCounts::branchMisses);
+
+  py::class_<RunResult>(m, "RunResult")
+    .def_readonly("parameters", &RunResult::parameters)
+    .def_readonly("solutions", &RunResult::solutions)
+    .def_readonly("averageFitnesses", &RunResult::averageFitnesses)
+    .def_readonly("bestFitnesses", &RunResult::bestFitnesses)
+    .def_readonly("worstFitnesses", &RunResult::worstFitnesses)
+    .def_readonly("fitnessCacheHitRates", &RunResult::fitnessCacheHitRates);
+
+  py::class_<RunProgress>(m, "RunProgress")
+    .def_readonly("isRunning", &RunProgress::isRunning)
+    .def_readonly("generationNumber", &RunProgress::generationNumber)
+    .def_readonly("bestFitness", &RunProgress::bestFitness)
+    .def_readonly("averageFitness", &RunProgress::averageFitness)
+    .def_readonly("worstFitness", &RunProgress::worstFitness)
+    .def_readonly("numEvaluations", &RunProgress::numEvaluations)
+    .def_readonly("numCachedEvaluations",
+                  &RunProgress::numCachedEvaluations)
+    .def_readonly("bestSolution", &RunProgress::bestSolution);
 }
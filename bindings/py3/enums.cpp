@@ -14,4 +14,33 @@ void createEnumBindings(py::module &m)
     .value("NONE", SelectionType::NONE)
     .value("RWS", SelectionType::RWS)
     .value("TS", SelectionType::TS);
+
+  py::enum_<ReplacementType>(m, "ReplacementType")
+    .value("GENERATIONAL", ReplacementType::GENERATIONAL)
+    .value("STEADY_STATE", ReplacementType::STEADY_STATE);
+
+  py::enum_<ConstraintHandlingType>(m, "ConstraintHandlingType")
+    .value("REJECTION", ConstraintHandlingType::REJECTION)
+    .value("PENALTY", ConstraintHandlingType::PENALTY);
+
+  py::enum_<GAPhase>(m, "GAPhase")
+    .value("INITIAL_POPULATION", GAPhase::INITIAL_POPULATION)
+    .value("SELECTION", GAPhase::SELECTION)
+    .value("CROSSOVER", GAPhase::CROSSOVER)
+    .value("MUTATION", GAPhase::MUTATION)
+    .value("FITNESS", GAPhase::FITNESS)
+    .value("FEASIBILITY", GAPhase::FEASIBILITY)
+    .value("REPLACEMENT", GAPhase::REPLACEMENT);
+
+  py::enum_<GeneEncoding>(m, "GeneEncoding")
+    .value("FULL", GeneEncoding::FULL)
+    .value("COMPACT", GeneEncoding::COMPACT);
+
+  py::enum_<MutationSelectionType>(m, "MutationSelectionType")
+    .value("UNIFORM", MutationSelectionType::UNIFORM)
+    .value("ADAPTIVE", MutationSelectionType::ADAPTIVE);
+
+  py::enum_<InitializationType>(m, "InitializationType")
+    .value("UNIFORM", InitializationType::UNIFORM)
+    .value("SCRAMBLED_HALTON", InitializationType::SCRAMBLED_HALTON);
 }
@@ -0,0 +1,60 @@
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+#include <EASTL/string.h>
+
+#include <bpt/bpt.hpp>
+
+#include <eastl.hpp>
+#include <io.hpp>
+
+namespace py = pybind11;
+
+using namespace bpt;
+
+void createIOBindings(py::module &m)
+{
+  m.def("writeProblemInstance", [](const std::string& filePath,
+                                   const ProblemInstance& instance) {
+    if (instance.flowMatrixFilePath.empty()
+        && instance.flowRates.getNumBuildings()
+           != instance.inputBuildings.size()) {
+      throw py::value_error(
+          "flowRates must have as many buildings as inputBuildings, unless "
+          "flowMatrixFilePath is set");
+    }
+
+    return writeProblemInstance(eastl::string{ filePath.c_str() }, instance);
+  });
+  m.def("readProblemInstance", [](const std::string& filePath) {
+    ProblemInstance instance;
+    if (!readProblemInstance(eastl::string{ filePath.c_str() }, instance)) {
+      throw py::value_error("cannot read problem instance file "
+                            + filePath);
+    }
+
+    return instance;
+  });
+  m.def("convertRowMajorFlowMatrixFile",
+        [](const std::string& rowMajorFilePath,
+           int numBuildings,
+           const std::string& filePath) {
+    return convertRowMajorFlowMatrixFile(
+        eastl::string{ rowMajorFilePath.c_str() },
+        numBuildings,
+        eastl::string{ filePath.c_str() });
+  });
+  m.def("writeRunResult", [](const std::string& filePath,
+                             const RunResult& result) {
+    return writeRunResult(eastl::string{ filePath.c_str() }, result);
+  });
+  m.def("readRunResult", [](const std::string& filePath) {
+    RunResult result;
+    if (!readRunResult(eastl::string{ filePath.c_str() }, result)) {
+      throw py::value_error("cannot read run result file " + filePath);
+    }
+
+    return result;
+  });
+}
@@ -0,0 +1,10 @@
+#ifndef BINDINGS_PY3_IO_HPP
+#define BINDINGS_PY3_IO_HPP
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void createIOBindings(py::module &m);
+
+#endif
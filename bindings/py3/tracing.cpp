@@ -0,0 +1,22 @@
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+#include <EASTL/string.h>
+
+#include <bpt/bpt.hpp>
+
+#include <tracing.hpp>
+
+namespace py = pybind11;
+
+using namespace bpt;
+
+void createTracingBindings(py::module &m)
+{
+  m.def("clearTrace", &clearTrace);
+  m.def("exportChromeTrace", [](const std::string& filePath) {
+    return exportChromeTrace(eastl::string{ filePath.c_str() });
+  });
+  m.def("isTracingEnabled", &isTracingEnabled);
+}
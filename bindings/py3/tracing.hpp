@@ -0,0 +1,10 @@
+#ifndef BINDINGS_PY3_TRACING_HPP
+#define BINDINGS_PY3_TRACING_HPP
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void createTracingBindings(py::module &m);
+
+#endif
@@ -0,0 +1,95 @@
+# Optimized builds of libbpt and pylibbpt with Clang profile-guided
+# optimization (PGO) and ThinLTO.
+#
+# Profiles are collected by running the training driver (tools/pgo-train/) on an
+# instrumented build, and then applied to an optimized build:
+#
+#   cmake -DCMAKE_BUILD_TYPE=Release -DBPT_PGO=GENERATE ..
+#   cmake --build . --target bpt-pgo-profile
+#   cmake -DBPT_PGO=USE -DBPT_ENABLE_THINLTO=ON ..
+#   cmake --build .
+#
+# The bpt-pgo-profile target builds and runs the training driver, and merges
+# the raw profiles it writes into BPT_PGO_PROFILE with llvm-profdata.
+
+set(BPT_PGO "OFF" CACHE STRING
+    "Profile-guided optimization mode: OFF, GENERATE or USE.")
+set_property(CACHE BPT_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(BPT_PGO_PROFILE "${CMAKE_BINARY_DIR}/pgo/bpt.profdata" CACHE FILEPATH
+    "Merged profile written in GENERATE mode and applied in USE mode.")
+option(BPT_ENABLE_THINLTO "Build with ThinLTO." OFF)
+
+set(BPT_PGO_RAW_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo/raw")
+
+if(NOT BPT_PGO STREQUAL "OFF" OR BPT_ENABLE_THINLTO)
+    if(CMAKE_BUILD_TYPE STREQUAL Debug)
+        message(WARNING
+            "PGO and ThinLTO are meant for optimized builds. Set "
+            "CMAKE_BUILD_TYPE to Release or RelWithDebInfo.")
+    endif()
+endif()
+
+if(BPT_PGO STREQUAL "GENERATE")
+    # %m keeps the profiles of different binaries apart, and %p those of
+    # different processes.
+    add_compile_options(
+        "-fprofile-instr-generate=${BPT_PGO_RAW_PROFILE_DIR}/bpt-%m-%p.profraw")
+    add_link_options(
+        "-fprofile-instr-generate=${BPT_PGO_RAW_PROFILE_DIR}/bpt-%m-%p.profraw")
+elseif(BPT_PGO STREQUAL "USE")
+    if(NOT EXISTS "${BPT_PGO_PROFILE}")
+        message(FATAL_ERROR
+            "No profile at ${BPT_PGO_PROFILE}. Build the bpt-pgo-profile "
+            "target with BPT_PGO set to GENERATE first.")
+    endif()
+
+    # Code that the training run did not reach, e.g. the bindings, is
+    # expected to have no profile.
+    add_compile_options("-fprofile-instr-use=${BPT_PGO_PROFILE}"
+                        -Wno-profile-instr-unprofiled
+                        -Wno-profile-instr-out-of-date)
+elseif(NOT BPT_PGO STREQUAL "OFF")
+    message(FATAL_ERROR "Unknown BPT_PGO mode: ${BPT_PGO}")
+endif()
+
+if(BPT_ENABLE_THINLTO)
+    # Static libraries have to hold LLVM bitcode, so they must be archived by
+    # the LLVM tools.
+    find_program(BPT_LLVM_AR NAMES llvm-ar-11 llvm-ar)
+    find_program(BPT_LLVM_RANLIB NAMES llvm-ranlib-11 llvm-ranlib)
+    if(NOT BPT_LLVM_AR OR NOT BPT_LLVM_RANLIB)
+        message(FATAL_ERROR "ThinLTO needs llvm-ar and llvm-ranlib.")
+    endif()
+    set(CMAKE_AR "${BPT_LLVM_AR}")
+    set(CMAKE_RANLIB "${BPT_LLVM_RANLIB}")
+
+    add_compile_options(-flto=thin)
+    add_link_options(-flto=thin -fuse-ld=lld)
+endif()
+
+message(STATUS "PGO: ${BPT_PGO}, ThinLTO: ${BPT_ENABLE_THINLTO}")
+
+# Builds the training driver, runs it, and merges its profiles.
+function(bpt_add_pgo_profile_target training_target)
+    if(NOT BPT_PGO STREQUAL "GENERATE")
+        return()
+    endif()
+
+    find_program(BPT_LLVM_PROFDATA NAMES llvm-profdata-11 llvm-profdata)
+    if(NOT BPT_LLVM_PROFDATA)
+        message(FATAL_ERROR "PGO GENERATE mode needs llvm-profdata.")
+    endif()
+    add_custom_target(bpt-pgo-profile
+        COMMAND ${CMAKE_COMMAND} -E remove_directory
+                "${BPT_PGO_RAW_PROFILE_DIR}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory
+                "${BPT_PGO_RAW_PROFILE_DIR}"
+        COMMAND $<TARGET_FILE:${training_target}>
+        COMMAND ${BPT_LLVM_PROFDATA} merge
+                "-output=${BPT_PGO_PROFILE}"
+                "${BPT_PGO_RAW_PROFILE_DIR}"
+        DEPENDS ${training_target}
+        COMMENT "Collecting PGO profiles with ${training_target}"
+        VERBATIM
+    )
+endfunction()
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <random>
+
+#include <EASTL/vector.h>
+
+#include <bpt/AdaptiveOperatorSelector.hpp>
+#include <bpt/random.hpp>
+
+namespace bpt
+{
+  AdaptiveOperatorSelector::AdaptiveOperatorSelector(int numOperators,
+                                                     float adaptationRate,
+                                                     float minProbability)
+      : numOperators(numOperators)
+      , adaptationRate(adaptationRate)
+      , minProbability(std::min(minProbability, 1.f / numOperators))
+      , probabilities()
+      , qualities()
+      , generationImprovements()
+      , generationSeconds()
+  {
+    this->reset();
+  }
+
+  int AdaptiveOperatorSelector::selectOperator()
+  {
+    std::uniform_real_distribution<float> selectionDistrib{ 0.f, 1.f };
+    float p = generateRandomReal(selectionDistrib);
+    for (int i = 0; i < this->numOperators - 1; i++) {
+      p -= this->probabilities[i];
+      if (p < 0.f) {
+        return i;
+      }
+    }
+
+    return this->numOperators - 1;
+  }
+
+  void AdaptiveOperatorSelector::recordApplication(int operatorIndex,
+                                                   double fitnessImprovement,
+                                                   double seconds)
+  {
+    this->generationImprovements[operatorIndex] += fitnessImprovement;
+    this->generationSeconds[operatorIndex] += static_cast<float>(seconds);
+  }
+
+  void AdaptiveOperatorSelector::updateProbabilities()
+  {
+    // Operators that were not applied in this generation keep their quality.
+    for (int i = 0; i < this->numOperators; i++) {
+      if (this->generationSeconds[i] > 0.f) {
+        const double reward = this->generationImprovements[i]
+                              / this->generationSeconds[i];
+        this->qualities[i] += this->adaptationRate
+                              * (reward - this->qualities[i]);
+      }
+    }
+
+    double qualitySum = 0.0;
+    for (double quality : this->qualities) {
+      qualitySum += quality;
+    }
+
+    for (int i = 0; i < this->numOperators; i++) {
+      if (qualitySum > 0.0) {
+        const float share = static_cast<float>(this->qualities[i]
+                                               / qualitySum);
+        this->probabilities[i] = this->minProbability
+                                 + ((1.f - (this->numOperators
+                                            * this->minProbability))
+                                    * share);
+      } else {
+        this->probabilities[i] = 1.f / this->numOperators;
+      }
+    }
+
+    std::fill(this->generationImprovements.begin(),
+              this->generationImprovements.end(),
+              0.0);
+    std::fill(this->generationSeconds.begin(),
+              this->generationSeconds.end(),
+              0.f);
+  }
+
+  void AdaptiveOperatorSelector::reset()
+  {
+    this->probabilities.assign(this->numOperators, 1.f / this->numOperators);
+    this->qualities.assign(this->numOperators, 0.0);
+    this->generationImprovements.assign(this->numOperators, 0.0);
+    this->generationSeconds.assign(this->numOperators, 0.f);
+  }
+
+  const eastl::vector<float>& AdaptiveOperatorSelector::getProbabilities() const
+  {
+    return this->probabilities;
+  }
+
+  const eastl::vector<float>&
+  AdaptiveOperatorSelector::getGenerationSeconds() const
+  {
+    return this->generationSeconds;
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef BPT_ADAPTIVE_OPERATOR_SELECTOR_HPP
+#define BPT_ADAPTIVE_OPERATOR_SELECTOR_HPP
+
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Picks one of several operators using probability matching. The reward
+  // of an operator is the fitness improvement it made per second spent
+  // applying it, over a generation. Rewards are folded into a quality
+  // estimate of each operator by exponential recency-weighted averaging.
+  // Operators are then picked with probabilities proportional to their
+  // qualities, with each operator keeping a minimum probability so that it
+  // can still be re-evaluated later on.
+  class AdaptiveOperatorSelector
+  {
+  public:
+    AdaptiveOperatorSelector(int numOperators,
+                             float adaptationRate,
+                             float minProbability);
+
+    int selectOperator();
+    void recordApplication(int operatorIndex,
+                           double fitnessImprovement,
+                           double seconds);
+    // Ends the current generation, updating the probabilities with the
+    // rewards of the applications recorded during it.
+    void updateProbabilities();
+    // Returns all operators to equal probabilities and qualities.
+    void reset();
+
+    const eastl::vector<float>& getProbabilities() const;
+    // Seconds spent on each operator in the current generation.
+    const eastl::vector<float>& getGenerationSeconds() const;
+  private:
+    int numOperators;
+    float adaptationRate;
+    float minProbability;
+    eastl::vector<float> probabilities;
+    eastl::vector<double> qualities;
+    eastl::vector<double> generationImprovements;
+    eastl::vector<float> generationSeconds;
+  };
+}
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef BPT_CONSTRAINT_HANDLING_TYPE
+#define BPT_CONSTRAINT_HANDLING_TYPE
+
+namespace bpt
+{
+  enum class ConstraintHandlingType { REJECTION, PENALTY };
+}
+
+#endif
@@ -1,18 +1,32 @@
 #include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <iostream>
+#include <chrono>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <random>
+#include <thread>
+#include <type_traits>
 
 #include <EASTL/array.h>
-#include <EASTL/functional.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/utility.h>
 #include <EASTL/vector.h>
 
 #include <corex/math.hpp>
 #include <corex/utils.hpp>
 
+#include <bpt/AdaptiveOperatorSelector.hpp>
 #include <bpt/ds.hpp>
 #include <bpt/GA.hpp>
+#include <bpt/geometry.hpp>
+#include <bpt/Island.hpp>
+#include <bpt/pareto.hpp>
+#include <bpt/PerfCounters.hpp>
+#include <bpt/random.hpp>
+#include <bpt/tracing.hpp>
 
 namespace bpt
 {
@@ -20,7 +34,32 @@ namespace bpt
       : currRunGenerationNumber(-1)
       , recentRunAvgFitnesses()
       , recentRunBestFitnesses()
-      , recentRunWorstFitnesses() {}
+      , recentRunWorstFitnesses()
+      , recentRunFitnessCacheHitRates()
+      , recentRunMutationProbabilities()
+      , recentRunMutationSeconds()
+      , fitnessCache()
+      , replacementType(ReplacementType::GENERATIONAL)
+      , geneEncoding(GeneEncoding::FULL)
+      , mutationSelectionType(MutationSelectionType::UNIFORM)
+      , mutationSelector(numMutations, 0.3f, 0.1f)
+      , island(nullptr)
+      , constraintHandlingType(ConstraintHandlingType::REJECTION)
+      , isCurrRunPenalized(false)
+      , penaltyCoefficient(0.0)
+      , minPenaltyCoefficient(0.0)
+      , maxPenaltyCoefficient(0.0)
+      , numFeasibleBestGenerations(0)
+      , numInfeasibleBestGenerations(0)
+      , initializationType(InitializationType::UNIFORM)
+      , initializationSequences()
+      , shouldSamplePerfCounters(false)
+      , perfCounters()
+      , recentRunPerfCounts()
+      , recentRunParetoFrontObjectives()
+      , numCurrRunEvaluations(0)
+      , numCurrRunCachedEvaluations(0)
+      , progressBoard() {}
 
   eastl::vector<eastl::vector<Solution>> GA::generateSolutions(
       const eastl::vector<InputBuilding>& inputBuildings,
@@ -39,162 +78,816 @@ namespace bpt
       const bool isLocalSearchEnabled,
       const SelectionType selectionType)
   {
-    assert(flowRates.size() == inputBuildings.size());
+    const Problem problem{
+        inputBuildings,
+        boundingArea,
+        flowRates,
+        floodProneAreas,
+        landslideProneAreas,
+        floodProneAreaPenalty,
+        landslideProneAreaPenalty,
+        buildingDistanceWeight
+    };
+    const GAParameters parameters{
+        mutationRate,
+        populationSize,
+        numGenerations,
+        tournamentSize,
+        numPrevGenOffsprings,
+        isLocalSearchEnabled,
+        selectionType
+    };
+
+    return this->generateSolutions(problem, parameters);
+  }
+
+  eastl::vector<eastl::vector<Solution>> GA::generateSolutions(
+      const Problem& problem,
+      const GAParameters& parameters)
+  {
+    return this->generateSolutions(problem,
+                                   parameters,
+                                   eastl::vector<Solution>{});
+  }
+
+  eastl::vector<eastl::vector<Solution>> GA::generateSolutions(
+      const Problem& problem,
+      const GAParameters& parameters,
+      const eastl::vector<Solution>& seedSolutions)
+  {
+    return this->runGA(problem, parameters, seedSolutions, false);
+  }
+
+  eastl::vector<eastl::vector<Solution>> GA::reoptimizeSolutions(
+      const Problem& prevProblem,
+      const Problem& problem,
+      const ProblemChange& change,
+      const eastl::vector<Solution>& prevPopulation,
+      const GAParameters& parameters)
+  {
+    const int prevNumBuildings = static_cast<int>(
+        prevProblem.inputBuildings.size());
+    eastl::vector<bool> isBuildingRemoved(prevNumBuildings, false);
+    for (const int buildingIndex : change.removedBuildings) {
+      assert(buildingIndex >= 0 && buildingIndex < prevNumBuildings);
+      isBuildingRemoved[buildingIndex] = true;
+    }
+
+    // Maps the remaining buildings to their indices in the previous problem.
+    eastl::vector<int> remainingBuildings;
+    for (int i = 0; i < prevNumBuildings; i++) {
+      if (!isBuildingRemoved[i]) {
+        remainingBuildings.push_back(i);
+      }
+    }
+
+    const int numRemainingBuildings = static_cast<int>(
+        remainingBuildings.size());
+    const int numBuildings = static_cast<int>(problem.inputBuildings.size());
+    assert(numRemainingBuildings + change.numAddedBuildings == numBuildings);
+
+    // Fitnesses can only be updated if the rest of the fitness function is
+    // unchanged. Penalized fitnesses are recomputed anyway when a run
+    // starts.
+    const bool isRescoringIncremental =
+        !change.areHazardAreasChanged
+        && prevProblem.floodProneAreaPenalty == problem.floodProneAreaPenalty
+        && prevProblem.landslideProneAreaPenalty
+           == problem.landslideProneAreaPenalty
+        && prevProblem.buildingDistanceWeight == problem.buildingDistanceWeight
+        && this->constraintHandlingType == ConstraintHandlingType::REJECTION;
+
+    struct FlowRateChange
+    {
+      int fromBuilding;
+      int toBuilding;
+      float delta;
+    };
+
+    // Solutions of a run with rejection are all feasible, so when their
+    // buildings keep their site, sizes and positions, only the inserted
+    // buildings could make them infeasible, and those are inserted at
+    // feasible positions already.
+    bool areRemainingBuildingsFeasible =
+        !change.isSiteChanged
+        && this->constraintHandlingType == ConstraintHandlingType::REJECTION;
+    for (int i = 0;
+         i < numRemainingBuildings && areRemainingBuildingsFeasible;
+         i++) {
+      const InputBuilding& prevBuilding =
+          prevProblem.inputBuildings[remainingBuildings[i]];
+      areRemainingBuildingsFeasible =
+          problem.inputBuildings[i].length == prevBuilding.length
+          && problem.inputBuildings[i].width == prevBuilding.width;
+    }
+
+    eastl::vector<FlowRateChange> flowRateChanges;
+    if (isRescoringIncremental) {
+      for (int i = 0; i < numRemainingBuildings; i++) {
+        for (int j = 0; j < numRemainingBuildings; j++) {
+          const float delta = problem.flowRates.getFlowRate(i, j)
+                              - prevProblem.flowRates.getFlowRate(
+                                  remainingBuildings[i],
+                                  remainingBuildings[j]);
+          if (i != j && delta != 0.f) {
+            flowRateChanges.push_back(FlowRateChange{ i, j, delta });
+          }
+        }
+      }
+    }
+
+    eastl::vector<Solution> seedSolutions;
+    for (const Solution& prevSolution : prevPopulation) {
+      if (prevSolution.getNumBuildings() != prevNumBuildings) {
+        continue;
+      }
+
+      // Take out the terms of the removed buildings first, while the
+      // previous solution is still at hand.
+      double fitness = prevSolution.getFitness();
+      if (isRescoringIncremental) {
+        for (const int removedBuilding : change.removedBuildings) {
+          for (int j = 0; j < prevNumBuildings; j++) {
+            if (j == removedBuilding) {
+              continue;
+            }
+
+            fitness -= this->computeFlowFitness(
+                prevSolution,
+                prevProblem,
+                removedBuilding,
+                j,
+                prevProblem.flowRates.getFlowRate(removedBuilding, j));
+
+            // Flows between two removed buildings are taken out when going
+            // through the other building.
+            if (!isBuildingRemoved[j]) {
+              fitness -= this->computeFlowFitness(
+                  prevSolution,
+                  prevProblem,
+                  j,
+                  removedBuilding,
+                  prevProblem.flowRates.getFlowRate(j, removedBuilding));
+            }
+          }
+
+          fitness -= this->computeHazardFitness(prevSolution,
+                                                prevProblem,
+                                                removedBuilding);
+        }
+      }
+
+      // Snapping rotations to the orientations of the new problem, and
+      // quantizing genes against its site, may move the remaining
+      // buildings, in which case their terms are stale too.
+      Solution solution = this->createEmptySolution(problem);
+      bool areBuildingsUnmoved = true;
+      for (int i = 0; i < numRemainingBuildings; i++) {
+        const int prevIndex = remainingBuildings[i];
+        solution.setBuildingXPos(i, prevSolution.getBuildingXPos(prevIndex));
+        solution.setBuildingYPos(i, prevSolution.getBuildingYPos(prevIndex));
+        solution.setBuildingRotation(
+            i, problem.footprintTable.snapRotation(
+                   prevSolution.getBuildingRotation(prevIndex)));
+
+        areBuildingsUnmoved =
+            areBuildingsUnmoved
+            && solution.getBuildingXPos(i)
+               == prevSolution.getBuildingXPos(prevIndex)
+            && solution.getBuildingYPos(i)
+               == prevSolution.getBuildingYPos(prevIndex)
+            && solution.getBuildingRotation(i)
+               == prevSolution.getBuildingRotation(prevIndex);
+      }
+
+      bool areBuildingsInserted = true;
+      for (int i = numRemainingBuildings;
+           i < numBuildings && areBuildingsInserted;
+           i++) {
+        areBuildingsInserted = this->insertBuilding(solution, i, problem);
+      }
+
+      if (!areBuildingsInserted) {
+        continue;
+      }
+
+      // Moved buildings may overlap even if the site is unchanged, so such
+      // seeds are checked in full. Repairing moves buildings around, so the
+      // fitness then has to be computed from scratch.
+      bool isRepaired = false;
+      if (!(areRemainingBuildingsFeasible && areBuildingsUnmoved)
+          && !this->isSolutionFeasible(solution, problem)) {
+        if (!this->repairSolution(solution, problem)) {
+          continue;
+        }
+
+        isRepaired = true;
+      }
+
+      if (isRescoringIncremental && areBuildingsUnmoved && !isRepaired) {
+        for (const FlowRateChange& flowRateChange : flowRateChanges) {
+          fitness += this->computeFlowFitness(solution,
+                                              problem,
+                                              flowRateChange.fromBuilding,
+                                              flowRateChange.toBuilding,
+                                              flowRateChange.delta);
+        }
 
-    eastl::vector<eastl::vector<Solution>> solutions;
-    eastl::vector<Solution> population(populationSize);
+        for (int i = numRemainingBuildings; i < numBuildings; i++) {
+          for (int j = 0; j < numBuildings; j++) {
+            if (j == i) {
+              continue;
+            }
+
+            fitness += this->computeFlowFitness(
+                solution, problem, i, j, problem.flowRates.getFlowRate(i, j));
+
+            // Flows between two added buildings are added when going
+            // through the other building.
+            if (j < numRemainingBuildings) {
+              fitness += this->computeFlowFitness(
+                  solution,
+                  problem,
+                  j,
+                  i,
+                  problem.flowRates.getFlowRate(j, i));
+            }
+          }
+
+          fitness += this->computeHazardFitness(solution, problem, i);
+        }
+      } else {
+        // The fitness cache still holds fitnesses for the previous problem
+        // at this point, and they are keyed by genes only.
+        fitness = this->computeUncachedSolutionFitness(solution, problem);
+      }
+
+      solution.setFitness(fitness);
+      seedSolutions.push_back(eastl::move(solution));
+    }
+
+    return this->runGA(
+        problem,
+        parameters,
+        seedSolutions,
+        this->constraintHandlingType == ConstraintHandlingType::REJECTION);
+  }
+
+  eastl::vector<eastl::vector<Solution>> GA::runGA(
+      const Problem& problem,
+      const GAParameters& parameters,
+      const eastl::vector<Solution>& seedSolutions,
+      const bool areSeedsScored)
+  {
+    RunState state;
+    state.shouldKeepHistory = true;
+
+    this->beginRun(state, problem, parameters, seedSolutions, areSeedsScored);
+    this->dispatchGenerations(state, problem, parameters.numGenerations);
+    this->endRun(state);
+
+    return eastl::move(state.history);
+  }
+
+  void GA::beginRun(RunState& state,
+                    const Problem& problem,
+                    const GAParameters& parameters,
+                    const eastl::vector<Solution>& seedSolutions,
+                    const bool areSeedsScored)
+  {
+    state.parameters = parameters;
+    state.population = eastl::vector<Solution>(parameters.populationSize);
+    state.history.clear();
+    state.populationHeap = MinMaxHeap<PopulationEntry>{};
+    state.isPopulationStale = false;
+    state.numGenerationsDone = 0;
+
+    eastl::vector<Solution>& population = state.population;
 
     this->recentRunAvgFitnesses.clear();
     this->recentRunBestFitnesses.clear();
     this->recentRunWorstFitnesses.clear();
+    this->recentRunFitnessCacheHitRates.clear();
+    this->recentRunMutationProbabilities.clear();
+    this->recentRunMutationSeconds.clear();
+    this->recentRunPerfCounts.clear();
+
+    // Runs go on without counters if none are available.
+    if (this->shouldSamplePerfCounters) {
+      this->perfCounters = eastl::make_unique<PerfCounters>();
+      if (!this->perfCounters->open()) {
+        this->perfCounters.reset();
+      }
+    }
 
-    std::cout << "|| Generating Initial Population..." << std::endl;
-    for (int i = 0; i < populationSize; i++) {
-      std::cout << "Generating solution #" << i << "..." << std::endl;
-      population[i] = this->generateRandomSolution(inputBuildings,
-                                                   boundingArea);
-      population[i].setFitness(
-          this->getSolutionFitness(
-              population[i],
-              inputBuildings,
-              flowRates,
-              floodProneAreas,
-              landslideProneAreas,
-              floodProneAreaPenalty,
-              landslideProneAreaPenalty,
-              buildingDistanceWeight));
+    if (this->mutationSelectionType == MutationSelectionType::ADAPTIVE) {
+      this->mutationSelector.reset();
+      this->recentRunMutationProbabilities.push_back(
+          this->mutationSelector.getProbabilities());
+    }
+
+    // Cached fitnesses are only valid for the problem they were computed for.
+    if (this->fitnessCache) {
+      this->fitnessCache->clear();
+    }
+
+    // The penalty coefficient is only known once there is a population, so
+    // the initial population is first scored without penalties.
+    state.isPenalized = this->constraintHandlingType
+                        == ConstraintHandlingType::PENALTY;
+    this->isCurrRunPenalized = state.isPenalized;
+    this->penaltyCoefficient = 0.0;
+    this->numFeasibleBestGenerations = 0;
+    this->numInfeasibleBestGenerations = 0;
+
+    this->numCurrRunEvaluations = 0;
+    this->numCurrRunCachedEvaluations = 0;
+    this->progressBoard.startRun();
+
+    this->generateInitialPopulation(population,
+                                    seedSolutions,
+                                    areSeedsScored,
+                                    problem);
+
+    if (state.isPenalized) {
+      this->penaltyCoefficient = this->computeInitialPenaltyCoefficient(
+          population, problem);
+      this->minPenaltyCoefficient = this->penaltyCoefficient * 1e-2;
+      this->maxPenaltyCoefficient = this->penaltyCoefficient * 1e6;
+
+      for (Solution& solution : population) {
+        solution.setFitness(this->computeSolutionFitness(solution, problem));
+      }
     }
 
     // Add the initial population.
-    solutions.push_back(population);
+    if (state.shouldKeepHistory) {
+      this->addPopulationToHistory(state.history, population);
+    }
+
+    this->releaseFootprintCaches(population);
 
-    Solution bestSolution = *std::min_element(
+    state.bestSolution = *std::min_element(
         population.begin(),
         population.end(),
-        [](Solution solutionA, Solution solutionB) {
+        [](const Solution& solutionA, const Solution& solutionB) {
           return cx::floatLessThan(solutionA.getFitness(),
                                             solutionB.getFitness());
         }
     );
-    Solution worstSolution = *std::max_element(
+    state.worstSolution = *std::max_element(
         population.begin(),
         population.end(),
-        [](Solution solutionA, Solution solutionB) {
+        [](const Solution& solutionA, const Solution& solutionB) {
           return cx::floatLessThan(solutionA.getFitness(),
                                             solutionB.getFitness());
         }
     );
 
+    state.bestFeasibleSolution = Solution{};
+    state.hasBestFeasibleSolution = false;
+    if (state.isPenalized) {
+      this->updateBestFeasibleSolution(population,
+                                       problem,
+                                       state.bestFeasibleSolution,
+                                       state.hasBestFeasibleSolution);
+    }
+
     // Add statistics about the initial population.
     double fitnessAverage = 0.0;
     for (Solution& sol : population) {
       fitnessAverage += sol.getFitness();
     }
 
-    fitnessAverage = fitnessAverage / population.size();
-    this->recentRunAvgFitnesses.push_back(static_cast<float>(fitnessAverage));
+    // In steady-state replacement, we keep track of the best and worst
+    // solutions, and the fitness sum incrementally instead.
+    state.fitnessSum = fitnessAverage;
+    if (this->replacementType == ReplacementType::STEADY_STATE) {
+      for (int i = 0; i < population.size(); i++) {
+        state.populationHeap.push(
+            PopulationEntry{ population[i].getFitness(), i });
+      }
+    }
 
-    this->recentRunBestFitnesses.push_back(static_cast<float>(
-                                               bestSolution.getFitness()));
+    state.fitnessAverage = fitnessAverage / population.size();
+    this->recordGenerationStatistics(state);
+  }
 
-    this->recentRunWorstFitnesses.push_back(static_cast<float>(
-                                                worstSolution.getFitness()));
+  void GA::dispatchGenerations(RunState& state,
+                               const Problem& problem,
+                               const int numGenerations)
+  {
+    const bool isMutationSelectionAdaptive =
+        this->mutationSelectionType == MutationSelectionType::ADAPTIVE;
+    switch (state.parameters.selectionType) {
+      case SelectionType::RWS:
+        if (isMutationSelectionAdaptive) {
+          this->runGenerations<RouletteWheelSelection,
+                               UniformCrossover,
+                               AdaptiveMutation>(state,
+                                                 problem,
+                                                 numGenerations);
+        } else {
+          this->runGenerations<RouletteWheelSelection,
+                               UniformCrossover,
+                               RandomMutation>(state,
+                                               problem,
+                                               numGenerations);
+        }
+        break;
+      case SelectionType::TS:
+      default:
+        if (isMutationSelectionAdaptive) {
+          this->runGenerations<TournamentSelection,
+                               UniformCrossover,
+                               AdaptiveMutation>(state,
+                                                 problem,
+                                                 numGenerations);
+        } else {
+          this->runGenerations<TournamentSelection,
+                               UniformCrossover,
+                               RandomMutation>(state,
+                                               problem,
+                                               numGenerations);
+        }
+        break;
+    }
+  }
 
-    const int numOffspringsToMake = populationSize - numPrevGenOffsprings;
-    for (int i = 0; i < numGenerations; i++) {
+  template <typename SelectionPolicy,
+            typename CrossoverPolicy,
+            typename MutationPolicy>
+  void GA::runGenerations(RunState& state,
+                          const Problem& problem,
+                          const int numGenerations)
+  {
+    const GAParameters& parameters = state.parameters;
+    eastl::vector<Solution>& population = state.population;
+    MinMaxHeap<PopulationEntry>& populationHeap = state.populationHeap;
+    double& fitnessSum = state.fitnessSum;
+    Solution& bestSolution = state.bestSolution;
+    Solution& worstSolution = state.worstSolution;
+    double& fitnessAverage = state.fitnessAverage;
+    const bool isRunPenalized = state.isPenalized;
+
+    // Only tournament selection takes a parameter.
+    const auto selectParents = [this, &parameters, &population]() {
+      if constexpr (std::is_same_v<SelectionPolicy, TournamentSelection>) {
+        return this->selectParents(SelectionPolicy{},
+                                   population,
+                                   parameters.tournamentSize);
+      } else {
+        return this->selectParents(SelectionPolicy{}, population);
+      }
+    };
+
+    const int numOffspringsToMake = parameters.populationSize
+                                    - parameters.numPrevGenOffsprings;
+    for (int generation = 0; generation < numGenerations; generation++) {
+      BPT_TRACE_SCOPE("generation");
       this->currRunGenerationNumber++;
 
-      int numOffsprings = 0;
-      eastl::vector<Solution> newOffsprings(numOffspringsToMake);
-      while (numOffsprings < numOffspringsToMake) {
-        // Standard Tournament Selection.
-        auto parents = this->selectParents(population,
-                                           tournamentSize,
-                                           selectionType);
-        Solution parentA = parents[0];
-        Solution parentB = parents[1];
-
-        // Make sure we have individuals from the population, and not just
-        // empty solutions.
-        assert(parentA.getNumBuildings() != 0);
-        assert(parentB.getNumBuildings() != 0);
-
-        // Breeding time.
-        this->makeTwoParentsBreed(parentA,
-                                  parentB,
-                                  newOffsprings,
-                                  numOffsprings,
-                                  numOffspringsToMake,
-                                  mutationRate,
-                                  boundingArea,
-                                  inputBuildings,
-                                  flowRates,
-                                  floodProneAreas,
-                                  landslideProneAreas,
-                                  floodProneAreaPenalty,
-                                  landslideProneAreaPenalty,
-                                  buildingDistanceWeight);
-      }
-
-      std::sort(
-          population.begin(),
-          population.end(),
-          [](Solution& solutionA, Solution& solutionB) {
-            return cx::floatLessThan(solutionA.getFitness(),
-                                              solutionB.getFitness());
-          }
-      );
+      if (state.isPopulationStale) {
+        this->rescorePopulation(population,
+                                populationHeap,
+                                fitnessSum,
+                                problem);
+        state.isPopulationStale = false;
+      }
 
-      // Keep only a set number of offsprings from the previous generation.
-      for (int i = numPrevGenOffsprings; i < population.size(); i++) {
-        population[i] = newOffsprings[i - numPrevGenOffsprings];
+      const int i = state.numGenerationsDone;
+      if (this->island != nullptr
+          && i > 0
+          && i % this->island->getMigrationInterval() == 0) {
+        this->exchangeMigrants(population,
+                               populationHeap,
+                               fitnessSum,
+                               problem);
+
+        const Solution* reportedBestSolution =
+            this->getReportedBestSolution(state);
+        if (reportedBestSolution != nullptr) {
+          this->island->reportBestSolution(*reportedBestSolution);
+        }
       }
 
-      std::sort(
-          population.begin(),
-          population.end(),
-          [](Solution& solutionA, Solution& solutionB) {
-            return cx::floatLessThan(solutionA.getFitness(),
-                                              solutionB.getFitness());
+      if (this->replacementType == ReplacementType::STEADY_STATE) {
+        for (int numOffsprings = 0;
+             numOffsprings < numOffspringsToMake;
+             numOffsprings += 2) {
+          const eastl::array<int, 2> parents = selectParents();
+          const Solution& parentA = population[parents[0]];
+          const Solution& parentB = population[parents[1]];
+          auto children = this->crossoverSolutions(CrossoverPolicy{},
+                                                   parentA,
+                                                   parentB,
+                                                   problem);
+          // Children are only evaluated once, after being mutated, so
+          // the parents stand in for their fitness before it. The parents
+          // may be replaced by the children below.
+          const double parentFitness = (parentA.getFitness()
+                                        + parentB.getFitness()) / 2.0;
+          for (Solution& child : children) {
+            this->finalizeOffspring<MutationPolicy>(child,
+                                                    parentFitness,
+                                                    parameters.mutationRate,
+                                                    problem);
+            this->replaceWorstSolution(child,
+                                       population,
+                                       populationHeap,
+                                       fitnessSum);
           }
-      );
+        }
 
-      bestSolution = population[0];
+        bestSolution = population[populationHeap.getMin().solutionIndex];
+        worstSolution = population[populationHeap.getMax().solutionIndex];
+        fitnessAverage = fitnessSum / population.size();
+      } else {
+        int numOffsprings = 0;
+        eastl::vector<Solution> newOffsprings(numOffspringsToMake);
+        while (numOffsprings < numOffspringsToMake) {
+          // Standard Tournament Selection. The population is only
+          // replaced once all offsprings are made, so the parents can be
+          // used in place.
+          const eastl::array<int, 2> parents = selectParents();
+          const Solution& parentA = population[parents[0]];
+          const Solution& parentB = population[parents[1]];
+
+          // Breeding time.
+          this->makeTwoParentsBreed<CrossoverPolicy, MutationPolicy>(
+              parentA,
+              parentB,
+              newOffsprings,
+              numOffsprings,
+              numOffspringsToMake,
+              parameters.mutationRate,
+              problem);
+        }
 
-      // Might add the local search feature in the future.
+        {
+          PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                         GAPhase::REPLACEMENT };
+          std::sort(
+              population.begin(),
+              population.end(),
+              [](const Solution& solutionA, const Solution& solutionB) {
+                return cx::floatLessThan(solutionA.getFitness(),
+                                         solutionB.getFitness());
+              }
+          );
+
+          // Keep only a set number of offsprings from the previous
+          // generation.
+          const int numPrevGenOffsprings = parameters.numPrevGenOffsprings;
+          for (int i = numPrevGenOffsprings; i < population.size(); i++) {
+            population[i] = eastl::move(
+                newOffsprings[i - numPrevGenOffsprings]);
+          }
 
-      bestSolution.setFitness(this->getSolutionFitness(
-          bestSolution,
-          inputBuildings,
-          flowRates,
-          floodProneAreas,
-          landslideProneAreas,
-          floodProneAreaPenalty,
-          landslideProneAreaPenalty,
-          buildingDistanceWeight));
+          std::sort(
+              population.begin(),
+              population.end(),
+              [](const Solution& solutionA, const Solution& solutionB) {
+                return cx::floatLessThan(solutionA.getFitness(),
+                                         solutionB.getFitness());
+              }
+          );
+        }
 
-      solutions.push_back(population);
+        // The fitness of every individual in the population has already been
+        // computed, so there is no need to evaluate the best solution again.
+        bestSolution = population[0];
+        worstSolution = population.back();
 
-      double fitnessAverage = 0.0;
-      for (Solution& sol : population) {
-        fitnessAverage += sol.getFitness();
+        fitnessAverage = 0.0;
+        for (Solution& sol : population) {
+          fitnessAverage += sol.getFitness();
+        }
+
+        fitnessAverage = fitnessAverage / population.size();
       }
 
-      fitnessAverage = fitnessAverage / population.size();
-      this->recentRunAvgFitnesses.push_back(static_cast<float>(fitnessAverage));
+      if (isRunPenalized) {
+        this->updateBestFeasibleSolution(population,
+                                         problem,
+                                         state.bestFeasibleSolution,
+                                         state.hasBestFeasibleSolution);
+      }
 
-      this->recentRunBestFitnesses.push_back(static_cast<float>(
-                                                 bestSolution.getFitness()));
+      // Might add the local search feature in the future.
 
-      worstSolution = population.back();
+      if (state.shouldKeepHistory) {
+        this->addPopulationToHistory(state.history, population);
+      }
+
+      this->releaseFootprintCaches(population);
 
-      this->recentRunWorstFitnesses.push_back(static_cast<float>(
-                                                  worstSolution.getFitness()));
+      state.numGenerationsDone++;
+      this->recordGenerationStatistics(state);
+
+      if (this->mutationSelectionType == MutationSelectionType::ADAPTIVE) {
+        this->recentRunMutationSeconds.push_back(
+            this->mutationSelector.getGenerationSeconds());
+        this->mutationSelector.updateProbabilities();
+        this->recentRunMutationProbabilities.push_back(
+            this->mutationSelector.getProbabilities());
+      }
+
+      // Adapting the penalty coefficient makes the current fitnesses stale.
+      if (isRunPenalized
+          && this->updatePenaltyCoefficient(
+              this->isSolutionFeasible(bestSolution, problem))) {
+        state.isPopulationStale = true;
+      }
     }
+  }
+
+  void GA::endRun(RunState& state)
+  {
+    const Solution* reportedBestSolution = this->getReportedBestSolution(
+        state);
+    if (this->island != nullptr && reportedBestSolution != nullptr) {
+      this->island->reportFinalSolution(*reportedBestSolution);
+    }
+
+    this->isCurrRunPenalized = false;
+    this->perfCounters.reset();
 
     this->currRunGenerationNumber = -1;
+    this->progressBoard.finishRun();
+  }
+
+  void GA::recordGenerationStatistics(const RunState& state)
+  {
+    this->recentRunAvgFitnesses.push_back(
+        static_cast<float>(state.fitnessAverage));
+
+    this->recentRunBestFitnesses.push_back(
+        this->getReportedBestFitness(state));
+
+    this->recentRunWorstFitnesses.push_back(static_cast<float>(
+                                                state.worstSolution
+                                                  .getFitness()));
+
+    this->recordFitnessCacheHitRate();
+    this->recordPerfCounts();
+
+    this->progressBoard.postProgress(
+        state.numGenerationsDone,
+        this->getReportedBestFitness(state),
+        static_cast<float>(state.fitnessAverage),
+        static_cast<float>(state.worstSolution.getFitness()),
+        this->numCurrRunEvaluations,
+        this->numCurrRunCachedEvaluations,
+        this->getReportedBestSolution(state));
+  }
+
+  const Solution* GA::getReportedBestSolution(const RunState& state) const
+  {
+    // With penalties, only feasible solutions may be reported as the best.
+    if (!state.isPenalized) {
+      return &state.bestSolution;
+    }
+
+    return state.hasBestFeasibleSolution
+           ? &state.bestFeasibleSolution
+           : nullptr;
+  }
+
+  float GA::getReportedBestFitness(const RunState& state) const
+  {
+    const Solution* bestSolution = this->getReportedBestSolution(state);
+    return (bestSolution != nullptr)
+           ? static_cast<float>(bestSolution->getFitness())
+           : std::numeric_limits<float>::infinity();
+  }
+
+  eastl::vector<RunResult> GA::generateSolutionsInBatch(
+      const Problem& problem,
+      const eastl::vector<GAParameters>& parameterSets,
+      const int numThreads)
+  {
+    eastl::vector<RunResult> results(parameterSets.size());
+
+    // Hand out the most expensive runs first, so that a long run started
+    // late does not leave the other threads idle at the end of the batch.
+    eastl::vector<int> runOrder(parameterSets.size());
+    for (int i = 0; i < runOrder.size(); i++) {
+      runOrder[i] = i;
+    }
+
+    auto estimateRunCost = [&parameterSets](int runIndex) -> double {
+      const GAParameters& parameters = parameterSets[runIndex];
+      return static_cast<double>(parameters.populationSize)
+             * static_cast<double>(parameters.numGenerations + 1);
+    };
+    std::stable_sort(runOrder.begin(),
+                     runOrder.end(),
+                     [&estimateRunCost](int runA, int runB) {
+                       return estimateRunCost(runA) > estimateRunCost(runB);
+                     });
+
+    std::atomic<int> nextRun{ 0 };
+    auto runWorker = [&]() {
+      while (true) {
+        const int orderIndex = nextRun++;
+        if (orderIndex >= runOrder.size()) {
+          break;
+        }
+
+        const int runIndex = runOrder[orderIndex];
+        GA runGA;
+        runGA.setFitnessCacheCapacity(this->getFitnessCacheCapacity());
+        runGA.setReplacementType(this->getReplacementType());
+        runGA.setGeneEncoding(this->getGeneEncoding());
+        runGA.setMutationSelectionType(this->getMutationSelectionType());
+        runGA.setConstraintHandlingType(this->getConstraintHandlingType());
+        runGA.setInitializationType(this->getInitializationType());
+
+        RunResult& result = results[runIndex];
+        result.parameters = parameterSets[runIndex];
+        result.solutions = runGA.generateSolutions(problem,
+                                                   parameterSets[runIndex]);
+        result.averageFitnesses = runGA.getRecentRunAverageFitnesses();
+        result.bestFitnesses = runGA.getRecentRunBestFitnesses();
+        result.worstFitnesses = runGA.getRecentRunWorstFitnesses();
+        result.fitnessCacheHitRates = runGA.getRecentRunFitnessCacheHitRates();
+      }
+    };
+
+    int numWorkers = numThreads;
+    if (numWorkers <= 0) {
+      numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
 
-    return solutions;
+    numWorkers = std::min(numWorkers, static_cast<int>(parameterSets.size()));
+
+    // The calling thread is one of the workers.
+    eastl::vector<std::thread> workers;
+    for (int i = 1; i < numWorkers; i++) {
+      workers.push_back(std::thread{ runWorker });
+    }
+
+    runWorker();
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+
+    return results;
+  }
+
+  void GA::scoreSolutions(const Problem& problem,
+                          const eastl::vector<Solution>& solutions,
+                          eastl::vector<double>& fitnesses,
+                          eastl::vector<uint8_t>& feasibilities,
+                          const int numThreads)
+  {
+    BPT_TRACE_SCOPE("scoring");
+    const int numSolutions = static_cast<int>(solutions.size());
+    fitnesses.resize(numSolutions);
+    feasibilities.resize(numSolutions);
+
+    // Solutions are handed out in chunks, so that threads do not contend
+    // over the next index, nor write next to each other too often.
+    constexpr int chunkSize = 64;
+    std::atomic<int> nextChunkStart{ 0 };
+    auto scoreWorker = [&]() {
+      while (true) {
+        const int chunkStart = nextChunkStart.fetch_add(chunkSize);
+        if (chunkStart >= numSolutions) {
+          break;
+        }
+
+        const int chunkEnd = std::min(chunkStart + chunkSize, numSolutions);
+        for (int i = chunkStart; i < chunkEnd; i++) {
+          const Solution& solution = solutions[i];
+          fitnesses[i] = this->computeUncachedSolutionFitness(solution,
+                                                              problem);
+          feasibilities[i] = this->isSolutionFeasible(solution, problem);
+        }
+      }
+    };
+
+    int numWorkers = numThreads;
+    if (numWorkers <= 0) {
+      numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const int numChunks = (numSolutions + chunkSize - 1) / chunkSize;
+    numWorkers = std::max(1, std::min(numWorkers, numChunks));
+
+    // The calling thread is one of the workers.
+    eastl::vector<std::thread> workers;
+    for (int i = 1; i < numWorkers; i++) {
+      workers.push_back(std::thread{ scoreWorker });
+    }
+
+    scoreWorker();
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
   }
 
   double GA::getSolutionFitness(
@@ -207,100 +900,737 @@ namespace bpt
       const float landslideProneAreaPenalty,
       const float buildingDistanceWeight)
   {
-    double fitness = 0.0;
-
-    // Compute fitness for the inter-building distance part.
-    for (int i = 0; i < solution.getNumBuildings(); i++) {
-      assert(flowRates[i].size() == solution.getNumBuildings());
-      for (int j = 1; j < solution.getNumBuildings(); j++) {
+    // The fitness cache is left alone, since its entries are only valid for
+    // the problem of the run that filled it.
+    const ObjectiveVector objectives = this->computeSolutionObjectives(
+        solution,
+        inputBuildings,
+        flowRates,
+        floodProneAreas,
+        landslideProneAreas);
+
+    double fitness = objectives[0] * buildingDistanceWeight;
+    fitness += static_cast<double>(floodProneAreaPenalty) * objectives[1];
+    fitness += static_cast<double>(landslideProneAreaPenalty) * objectives[2];
+
+    return fitness;
+  }
+
+  eastl::vector<Solution> GA::generateParetoFront(
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const cx::NPolygon& boundingArea,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas,
+      const float mutationRate,
+      const int populationSize,
+      const int numGenerations)
+  {
+    // Penalties and weights are not used in multi-objective runs.
+    const Problem problem{
+        inputBuildings,
+        boundingArea,
+        flowRates,
+        floodProneAreas,
+        landslideProneAreas,
+        0.f,
+        0.f,
+        1.f
+    };
+
+    return this->generateParetoFront(problem,
+                                     mutationRate,
+                                     populationSize,
+                                     numGenerations);
+  }
+
+  eastl::vector<Solution> GA::generateParetoFront(
+      const Problem& problem,
+      const float mutationRate,
+      const int populationSize,
+      const int numGenerations)
+  {
+    assert(populationSize > 0);
+
+    this->recentRunParetoFrontObjectives.clear();
+
+    this->numCurrRunEvaluations = 0;
+    this->numCurrRunCachedEvaluations = 0;
+    this->progressBoard.startRun();
+
+    // There is no single best solution, so only the generation number and
+    // the number of evaluations are posted.
+    constexpr float noFitness = std::numeric_limits<float>::quiet_NaN();
+    auto postProgress = [&](const int generationNumber) {
+      this->progressBoard.postProgress(generationNumber,
+                                       noFitness,
+                                       noFitness,
+                                       noFitness,
+                                       this->numCurrRunEvaluations,
+                                       0,
+                                       nullptr);
+    };
+
+    // The parents and offsprings of a generation share one pool. The
+    // parents always occupy the first populationSize slots.
+    eastl::vector<Solution> pool;
+    eastl::vector<ObjectiveVector> poolObjectives;
+    pool.reserve(populationSize * 2);
+    poolObjectives.reserve(populationSize * 2);
+
+    this->resetInitializationSequences(problem);
+    for (int i = 0; i < populationSize; i++) {
+      pool.push_back(this->generateRandomSolution(problem));
+      poolObjectives.push_back(this->computeSolutionObjectives(pool.back(),
+                                                               problem));
+      this->numCurrRunEvaluations++;
+    }
+
+    eastl::vector<int> ranks;
+    eastl::vector<double> crowdingDistances;
+    this->selectParetoSurvivors(pool,
+                                poolObjectives,
+                                ranks,
+                                crowdingDistances,
+                                populationSize);
+    postProgress(0);
+
+    std::uniform_int_distribution<int> parentDistrib{ 0, populationSize - 1 };
+    std::uniform_real_distribution<float> mutationChanceDistribution{
+        0.f, 1.f
+    };
+
+    // Binary tournament using the crowded-comparison operator.
+    auto selectParent = [&]() -> int {
+      const int candidateA = generateRandomInt(parentDistrib);
+      const int candidateB = generateRandomInt(parentDistrib);
+      if (ranks[candidateA] != ranks[candidateB]) {
+        return (ranks[candidateA] < ranks[candidateB])
+               ? candidateA
+               : candidateB;
+      }
+
+      return (crowdingDistances[candidateA] > crowdingDistances[candidateB])
+             ? candidateA
+             : candidateB;
+    };
+
+    for (int i = 0; i < numGenerations; i++) {
+      this->currRunGenerationNumber++;
+
+      while (pool.size() < populationSize * 2) {
+        const int parentA = selectParent();
+        const int parentB = selectParent();
+        auto children = this->crossoverSolutions(UniformCrossover{},
+                                                 pool[parentA],
+                                                 pool[parentB],
+                                                 problem);
+        for (Solution& child : children) {
+          if (pool.size() == populationSize * 2) {
+            break;
+          }
+
+          float mutationProbability = generateRandomReal(
+              mutationChanceDistribution);
+          if (cx::floatLessThan(mutationProbability, mutationRate)) {
+            this->mutateSolution(RandomMutation{},
+                                 child,
+                                 problem);
+          }
+
+          poolObjectives.push_back(this->computeSolutionObjectives(child,
+                                                                   problem));
+          this->numCurrRunEvaluations++;
+          pool.push_back(eastl::move(child));
+        }
+      }
+
+      this->selectParetoSurvivors(pool,
+                                  poolObjectives,
+                                  ranks,
+                                  crowdingDistances,
+                                  populationSize);
+      postProgress(i + 1);
+    }
+
+    this->currRunGenerationNumber = -1;
+    this->progressBoard.finishRun();
+
+    eastl::vector<Solution> paretoFront;
+    for (int i = 0; i < pool.size(); i++) {
+      if (ranks[i] == 0) {
+        pool[i].clearFootprintCache();
+        paretoFront.push_back(pool[i]);
+        this->recentRunParetoFrontObjectives.push_back(
+            eastl::vector<double>(poolObjectives[i].begin(),
+                                  poolObjectives[i].end()));
+      }
+    }
+
+    return paretoFront;
+  }
+
+  eastl::vector<double> GA::getSolutionObjectives(
+      const Solution& solution,
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas)
+  {
+    const ObjectiveVector objectives = this->computeSolutionObjectives(
+        solution,
+        inputBuildings,
+        flowRates,
+        floodProneAreas,
+        landslideProneAreas);
+    return eastl::vector<double>(objectives.begin(), objectives.end());
+  }
+
+  eastl::vector<eastl::vector<double>> GA::getRecentRunParetoFrontObjectives()
+  {
+    return this->recentRunParetoFrontObjectives;
+  }
+
+  int GA::getCurrentRunGenerationNumber()
+  {
+    return this->currRunGenerationNumber;
+  }
+
+  RunProgress GA::getCurrentRunProgress()
+  {
+    return this->progressBoard.readProgress();
+  }
+
+  eastl::vector<float> GA::getRecentRunAverageFitnesses()
+  {
+    return this->recentRunAvgFitnesses;
+  }
+
+  eastl::vector<float> GA::getRecentRunBestFitnesses()
+  {
+    return this->recentRunBestFitnesses;
+  }
+
+  eastl::vector<float> GA::getRecentRunWorstFitnesses()
+  {
+    return this->recentRunWorstFitnesses;
+  }
+
+  eastl::vector<float> GA::getRecentRunFitnessCacheHitRates()
+  {
+    return this->recentRunFitnessCacheHitRates;
+  }
+
+  eastl::vector<eastl::vector<float>> GA::getRecentRunMutationProbabilities()
+  {
+    return this->recentRunMutationProbabilities;
+  }
+
+  eastl::vector<eastl::vector<float>> GA::getRecentRunMutationSeconds()
+  {
+    return this->recentRunMutationSeconds;
+  }
+
+  void GA::setFitnessCacheCapacity(const int capacity)
+  {
+    if (capacity > 0) {
+      this->fitnessCache = eastl::make_unique<FitnessCache>(capacity);
+    } else {
+      this->fitnessCache.reset();
+    }
+  }
+
+  int GA::getFitnessCacheCapacity()
+  {
+    return (this->fitnessCache) ? this->fitnessCache->getCapacity() : 0;
+  }
+
+  void GA::setReplacementType(const ReplacementType replacementType)
+  {
+    this->replacementType = replacementType;
+  }
+
+  ReplacementType GA::getReplacementType()
+  {
+    return this->replacementType;
+  }
+
+  void GA::setGeneEncoding(const GeneEncoding geneEncoding)
+  {
+    this->geneEncoding = geneEncoding;
+  }
+
+  GeneEncoding GA::getGeneEncoding()
+  {
+    return this->geneEncoding;
+  }
+
+  void GA::setMutationSelectionType(
+      const MutationSelectionType mutationSelectionType)
+  {
+    this->mutationSelectionType = mutationSelectionType;
+  }
+
+  MutationSelectionType GA::getMutationSelectionType()
+  {
+    return this->mutationSelectionType;
+  }
+
+  void GA::setIsland(Island* island)
+  {
+    this->island = island;
+  }
+
+  void GA::setPerfCounterSampling(const bool isEnabled)
+  {
+    this->shouldSamplePerfCounters = isEnabled;
+  }
+
+  bool GA::isPerfCounterSamplingEnabled()
+  {
+    return this->shouldSamplePerfCounters;
+  }
+
+  eastl::vector<eastl::vector<PerfCounts>> GA::getRecentRunPerfCounts()
+  {
+    return this->recentRunPerfCounts;
+  }
+
+  void GA::setConstraintHandlingType(
+      const ConstraintHandlingType constraintHandlingType)
+  {
+    this->constraintHandlingType = constraintHandlingType;
+  }
+
+  ConstraintHandlingType GA::getConstraintHandlingType()
+  {
+    return this->constraintHandlingType;
+  }
+
+  void GA::setInitializationType(
+      const InitializationType initializationType)
+  {
+    this->initializationType = initializationType;
+  }
+
+  InitializationType GA::getInitializationType()
+  {
+    return this->initializationType;
+  }
+
+  double GA::computeSolutionFitness(const Solution& solution,
+                                    const Problem& problem)
+  {
+    BPT_TRACE_SCOPE("fitness");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::FITNESS };
+    double fitness = 0.0;
+
+    // Only the unpenalized fitness is cached, since the penalty coefficient
+    // changes during a run.
+    uint64_t cacheKey = 0;
+    bool isFitnessCached = false;
+    if (this->fitnessCache) {
+      cacheKey = FitnessCache::computeSolutionKey(solution);
+      isFitnessCached = this->fitnessCache->findFitness(cacheKey, fitness);
+    }
+
+    this->numCurrRunEvaluations++;
+    if (isFitnessCached) {
+      this->numCurrRunCachedEvaluations++;
+    } else {
+      fitness = this->computeUncachedSolutionFitness(solution, problem);
+
+      if (this->fitnessCache) {
+        this->fitnessCache->insertFitness(cacheKey, fitness);
+      }
+    }
+
+    if (this->isCurrRunPenalized && this->penaltyCoefficient > 0.0) {
+      fitness += this->penaltyCoefficient
+                 * this->computeConstraintViolation(solution, problem);
+    }
+
+    return fitness;
+  }
+
+  double GA::computeUncachedSolutionFitness(const Solution& solution,
+                                            const Problem& problem)
+  {
+    const ObjectiveVector objectives = this->computeSolutionObjectives(
+        solution, problem);
+
+    double fitness = objectives[0] * problem.buildingDistanceWeight;
+    fitness += static_cast<double>(problem.floodProneAreaPenalty)
+               * objectives[1];
+    fitness += static_cast<double>(problem.landslideProneAreaPenalty)
+               * objectives[2];
+
+    return fitness;
+  }
+
+  double GA::computeConstraintViolation(const Solution& solution,
+                                        const Problem& problem)
+  {
+    const SiteBoundary& boundingArea = problem.boundingArea;
+
+    double violation = 0.0;
+    for (int i = 0; i < solution.getNumBuildings(); i++) {
+      const Footprint& building0 = solution.getBuildingFootprint(
+          i, problem.footprintTable);
+      if (!boundingArea.isFootprintWithin(building0)) {
+        violation += computeFootprintAreaOutsideNPolygon(
+            building0, boundingArea.getPolygon());
+      }
+
+      for (int j = i + 1; j < solution.getNumBuildings(); j++) {
+        const Footprint& building1 = solution.getBuildingFootprint(
+            j, problem.footprintTable);
+        violation += computeFootprintOverlapArea(building0, building1);
+      }
+    }
+
+    return violation;
+  }
+
+  double GA::computeInitialPenaltyCoefficient(
+      const eastl::vector<Solution>& population,
+      const Problem& problem)
+  {
+    // Start with a coefficient that makes a violation as large as the total
+    // area of the buildings cost about as much as an average layout, so that
+    // neither the objectives nor the constraints dominate at first.
+    double totalBuildingArea = 0.0;
+    for (const InputBuilding& building : problem.inputBuildings) {
+      totalBuildingArea += static_cast<double>(building.length)
+                           * static_cast<double>(building.width);
+    }
+
+    double averageFitness = 0.0;
+    for (const Solution& solution : population) {
+      averageFitness += this->computeUncachedSolutionFitness(solution,
+                                                             problem);
+    }
+
+    averageFitness /= std::max(static_cast<int>(population.size()), 1);
+
+    return std::max(averageFitness, 1.0)
+           / std::max(totalBuildingArea, 1e-6);
+  }
+
+  bool GA::updatePenaltyCoefficient(const bool isBestSolutionFeasible)
+  {
+    // After Hadj-Alouane and Bean. When the best solution has been feasible
+    // for a few generations in a row, the penalty is lowered, so that the
+    // search can cut through infeasible regions. When it has been
+    // infeasible, the penalty is raised, to push the search back to
+    // feasible regions.
+    constexpr int numAdaptationGenerations = 3;
+    constexpr double decreaseFactor = 2.0;
+    constexpr double increaseFactor = 1.5;
+
+    if (isBestSolutionFeasible) {
+      this->numFeasibleBestGenerations++;
+      this->numInfeasibleBestGenerations = 0;
+    } else {
+      this->numInfeasibleBestGenerations++;
+      this->numFeasibleBestGenerations = 0;
+    }
+
+    const double prevPenaltyCoefficient = this->penaltyCoefficient;
+    if (this->numFeasibleBestGenerations == numAdaptationGenerations) {
+      this->penaltyCoefficient = std::max(
+          this->penaltyCoefficient / decreaseFactor,
+          this->minPenaltyCoefficient);
+      this->numFeasibleBestGenerations = 0;
+    } else if (this->numInfeasibleBestGenerations
+               == numAdaptationGenerations) {
+      this->penaltyCoefficient = std::min(
+          this->penaltyCoefficient * increaseFactor,
+          this->maxPenaltyCoefficient);
+      this->numInfeasibleBestGenerations = 0;
+    }
+
+    return this->penaltyCoefficient != prevPenaltyCoefficient;
+  }
+
+  void GA::updateBestFeasibleSolution(
+      const eastl::vector<Solution>& population,
+      const Problem& problem,
+      Solution& bestFeasibleSolution,
+      bool& hasBestFeasibleSolution)
+  {
+    // Feasible solutions have no penalty, so their fitnesses stay comparable
+    // across changes of the penalty coefficient.
+    for (const Solution& solution : population) {
+      if (hasBestFeasibleSolution
+          && !cx::floatLessThan(solution.getFitness(),
+                                bestFeasibleSolution.getFitness())) {
+        continue;
+      }
+
+      if (this->isSolutionFeasible(solution, problem)) {
+        bestFeasibleSolution = solution;
+        hasBestFeasibleSolution = true;
+      }
+    }
+  }
+
+  void GA::rescorePopulation(
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum,
+      const Problem& problem)
+  {
+    fitnessSum = 0.0;
+    for (Solution& solution : population) {
+      solution.setFitness(this->computeSolutionFitness(solution, problem));
+      fitnessSum += solution.getFitness();
+    }
+
+    if (this->replacementType == ReplacementType::STEADY_STATE) {
+      populationHeap.clear();
+      for (int i = 0; i < population.size(); i++) {
+        populationHeap.push(PopulationEntry{ population[i].getFitness(), i });
+      }
+    }
+  }
+
+  double GA::computeFlowFitness(const Solution& solution,
+                                const Problem& problem,
+                                const int fromBuilding,
+                                const int toBuilding,
+                                const float flowRate)
+  {
+    const double flowCost = static_cast<double>(
+        cx::distance2D(cx::Point{
+                          solution.getBuildingXPos(fromBuilding),
+                          solution.getBuildingYPos(fromBuilding)
+                       },
+                       cx::Point{
+                          solution.getBuildingXPos(toBuilding),
+                          solution.getBuildingYPos(toBuilding)
+                       })
+        * flowRate);
+    return flowCost * problem.buildingDistanceWeight;
+  }
+
+  double GA::computeHazardFitness(const Solution& solution,
+                                  const Problem& problem,
+                                  const int buildingIndex)
+  {
+    const Footprint& building = solution.getBuildingFootprint(
+        buildingIndex, problem.footprintTable);
+    return (static_cast<double>(problem.floodProneAreaPenalty)
+            * problem.floodProneAreas.countPolygonsIntersectingFootprint(
+                  building))
+           + (static_cast<double>(problem.landslideProneAreaPenalty)
+              * problem.landslideProneAreas.countPolygonsIntersectingFootprint(
+                    building));
+  }
+
+  ObjectiveVector GA::computeSolutionObjectives(const Solution& solution,
+                                                const Problem& problem)
+  {
+    const FlowMatrix& flowRates = problem.flowRates;
+    const int numBuildings = solution.getNumBuildings();
+    assert(flowRates.getNumBuildings() == numBuildings);
+
+    ObjectiveVector objectives{ 0.0, 0.0, 0.0 };
+
+    // Compute the inter-building distance part. The flow rates are gone
+    // through tile by tile, so that each tile stays in cache while in use.
+    for (int tileRow = 0; tileRow < flowRates.getNumTiles(); tileRow++) {
+      const int firstRow = tileRow * FlowMatrix::tileSize;
+      const int lastRow = std::min(firstRow + FlowMatrix::tileSize,
+                                   numBuildings);
+      for (int tileColumn = 0;
+           tileColumn < flowRates.getNumTiles();
+           tileColumn++) {
+        const float* tile = flowRates.getTile(tileRow, tileColumn);
+        const int firstColumn = tileColumn * FlowMatrix::tileSize;
+        const int lastColumn = std::min(firstColumn + FlowMatrix::tileSize,
+                                        numBuildings);
+        for (int i = firstRow; i < lastRow; i++) {
+          const cx::Point position0{
+            solution.getBuildingXPos(i),
+            solution.getBuildingYPos(i)
+          };
+          const float* tileFlowRates = tile
+                                       + ((i - firstRow)
+                                          * FlowMatrix::tileSize);
+          for (int j = firstColumn; j < lastColumn; j++) {
+            if (i == j) {
+              continue;
+            }
+
+            objectives[0] += static_cast<double>(
+                cx::distance2D(position0,
+                               cx::Point{
+                                 solution.getBuildingXPos(j),
+                                 solution.getBuildingYPos(j)
+                               })
+                * tileFlowRates[j - firstColumn]
+            );
+          }
+        }
+      }
+    }
+
+    // Count the number of times buildings are placed in hazard areas.
+    for (int i = 0; i < solution.getNumBuildings(); i++) {
+      const Footprint& building = solution.getBuildingFootprint(
+          i, problem.footprintTable);
+      objectives[1] += problem.floodProneAreas
+                           .countPolygonsIntersectingFootprint(building);
+      objectives[2] += problem.landslideProneAreas
+                           .countPolygonsIntersectingFootprint(building);
+    }
+
+    return objectives;
+  }
+
+  ObjectiveVector GA::computeSolutionObjectives(
+      const Solution& solution,
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas)
+  {
+    const int numBuildings = solution.getNumBuildings();
+    assert(static_cast<int>(inputBuildings.size()) == numBuildings);
+    assert(static_cast<int>(flowRates.size()) == numBuildings);
+
+    ObjectiveVector objectives{ 0.0, 0.0, 0.0 };
+    for (int i = 0; i < numBuildings; i++) {
+      assert(static_cast<int>(flowRates[i].size()) == numBuildings);
+      const cx::Point position0{
+        solution.getBuildingXPos(i),
+        solution.getBuildingYPos(i)
+      };
+      for (int j = 0; j < numBuildings; j++) {
         if (i == j) {
           continue;
         }
 
-        fitness += static_cast<double>(
-            cx::distance2D(cx::Point{
-                                        solution.getBuildingXPos(i),
-                                        solution.getBuildingYPos(i)
-                                    },
-                                    cx::Point{
-                                        solution.getBuildingXPos(j),
-                                        solution.getBuildingYPos(j)
-                                    })
+        objectives[0] += static_cast<double>(
+            cx::distance2D(position0,
+                           cx::Point{
+                             solution.getBuildingXPos(j),
+                             solution.getBuildingYPos(j)
+                           })
             * flowRates[i][j]
         );
       }
     }
 
-    fitness *= buildingDistanceWeight;
-
-    // Compute penalty for placing buildings in hazard areas.
-    for (int i = 0; i < solution.getNumBuildings(); i++) {
-      cx::Rectangle building {
+    // The footprints are not cached, since the solution may be scored
+    // against other input buildings next time.
+    for (int i = 0; i < numBuildings; i++) {
+      const Footprint building = computeBuildingFootprint(
           solution.getBuildingXPos(i),
           solution.getBuildingYPos(i),
-          inputBuildings[i].width,
-          inputBuildings[i].length,
-          solution.getBuildingRotation(i)
-      };
-      // Compute penalty for placing a building in a flood-prone area.
+          solution.getBuildingRotation(i),
+          inputBuildings[i]);
       for (const cx::NPolygon& area : floodProneAreas) {
-        if (cx::isRectIntersectingNPolygon(building, area)) {
-          fitness += floodProneAreaPenalty;
+        if (isFootprintIntersectingNPolygon(building, area)) {
+          objectives[1] += 1.0;
         }
       }
 
-      // Compute penalty for placing a building in a landslide-prone area.
       for (const cx::NPolygon& area : landslideProneAreas) {
-        if (cx::isRectIntersectingNPolygon(building, area)) {
-          fitness += landslideProneAreaPenalty;
+        if (isFootprintIntersectingNPolygon(building, area)) {
+          objectives[2] += 1.0;
         }
       }
     }
 
-    return fitness;
+    return objectives;
   }
 
-  int GA::getCurrentRunGenerationNumber()
+  void GA::selectParetoSurvivors(
+      eastl::vector<Solution>& pool,
+      eastl::vector<ObjectiveVector>& poolObjectives,
+      eastl::vector<int>& ranks,
+      eastl::vector<double>& crowdingDistances,
+      const int populationSize)
   {
-    return this->currRunGenerationNumber;
-  }
+    // Fill the next population front by front. The front that does not fit
+    // entirely gets truncated, keeping its least crowded members.
+    const auto fronts = sortIntoNonDominatedFronts(poolObjectives);
+
+    eastl::vector<Solution> survivors;
+    eastl::vector<ObjectiveVector> survivorObjectives;
+    survivors.reserve(populationSize * 2);
+    survivorObjectives.reserve(populationSize * 2);
+    ranks.clear();
+    crowdingDistances.clear();
+    for (int rank = 0; rank < fronts.size(); rank++) {
+      if (survivors.size() == populationSize) {
+        break;
+      }
 
-  eastl::vector<float> GA::getRecentRunAverageFitnesses()
-  {
-    return this->recentRunAvgFitnesses;
-  }
+      const eastl::vector<int>& front = fronts[rank];
+      const eastl::vector<double> distances = computeCrowdingDistances(
+          poolObjectives, front);
 
-  eastl::vector<float> GA::getRecentRunBestFitnesses()
-  {
-    return this->recentRunBestFitnesses;
+      eastl::vector<int> order(front.size());
+      for (int i = 0; i < front.size(); i++) {
+        order[i] = i;
+      }
+
+      const int numRemaining = populationSize
+                               - static_cast<int>(survivors.size());
+      if (front.size() > numRemaining) {
+        std::sort(order.begin(),
+                  order.end(),
+                  [&distances](int a, int b) {
+                    return distances[a] > distances[b];
+                  });
+        order.resize(numRemaining);
+      }
+
+      for (int i : order) {
+        survivors.push_back(eastl::move(pool[front[i]]));
+        survivorObjectives.push_back(poolObjectives[front[i]]);
+        ranks.push_back(rank);
+        crowdingDistances.push_back(distances[i]);
+      }
+    }
+
+    pool = eastl::move(survivors);
+    poolObjectives = eastl::move(survivorObjectives);
   }
 
-  eastl::vector<float> GA::getRecentRunWorstFitnesses()
+  void GA::recordFitnessCacheHitRate()
   {
-    return this->recentRunWorstFitnesses;
+    if (this->fitnessCache) {
+      this->recentRunFitnessCacheHitRates.push_back(
+          this->fitnessCache->getHitRate());
+      this->fitnessCache->resetStatistics();
+    } else {
+      this->recentRunFitnessCacheHitRates.push_back(0.f);
+    }
   }
 
-  eastl::array<Solution, 2> GA::selectParents(
-      const eastl::vector<Solution>& population,
-      const int& tournamentSize,
-      const SelectionType& selectionType)
+  void GA::recordPerfCounts()
   {
-    eastl::array<Solution, 2> parents;
-    switch (selectionType) {
-      case SelectionType::RWS:
-        parents = this->runRouletteWheelSelection(population);
-      case SelectionType::TS:
-        parents = this->runTournamentSelection(population, tournamentSize);
-      default:
-        break;
+    if (!this->perfCounters) {
+      return;
     }
 
-    return parents;
+    const auto phaseCounts = this->perfCounters->takeCounts();
+    this->recentRunPerfCounts.push_back(eastl::vector<PerfCounts>(
+        phaseCounts.begin(), phaseCounts.end()));
   }
 
-  eastl::array<Solution, 2> GA::runRouletteWheelSelection(
+  eastl::array<int, 2> GA::selectParents(
+      RouletteWheelSelection,
       const eastl::vector<Solution>& population)
   {
+    BPT_TRACE_SCOPE("selection");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::SELECTION };
     // Let's try roulette wheel selection. Code based from:
     //   https://stackoverflow.com/a/26316267/1116098
     eastl::vector<double> popFitnesses;
@@ -310,7 +1640,7 @@ namespace bpt
 
     double fitnessSum = std::accumulate(popFitnesses.begin(),
                                         popFitnesses.end(),
-                                        0);
+                                        0.0);
     double maxFitness = *std::max_element(
         popFitnesses.begin(),
         popFitnesses.end(),
@@ -327,15 +1657,15 @@ namespace bpt
 
     std::uniform_real_distribution<double> fitnessDistrib {0, fitnessSum };
 
-    eastl::array<Solution, 2> parents;
+    eastl::array<int, 2> parents;
     for (int i = 0; i < parents.size(); i++) {
-      double p = cx::generateRandomReal(fitnessDistrib);
-      parents[i] = population[0]; // Default selection.
+      double p = generateRandomReal(fitnessDistrib);
+      parents[i] = 0; // Default selection.
       for (int j = 0; j < popFitnesses.size(); j++) {
-        p -= upperBound - popFitnesses[i];
+        p -= upperBound - popFitnesses[j];
 
         if (cx::floatLessEqual(p, 0.f)) {
-          parents[i] = population[j];
+          parents[i] = j;
           break;
         }
       }
@@ -344,32 +1674,45 @@ namespace bpt
     return parents;
   }
 
-  eastl::array<Solution, 2> GA::runTournamentSelection(
+  eastl::array<int, 2> GA::selectParents(
+      TournamentSelection,
       const eastl::vector<Solution>& population,
-      const int& tournamentSize)
+      const int tournamentSize)
   {
+    BPT_TRACE_SCOPE("selection");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::SELECTION };
     std::uniform_int_distribution<int> chromosomeDistribution{
         0, static_cast<int>(population.size() - 1)
     };
 
-    eastl::array<Solution, 2> parents;
+    // -1 until a parent is picked.
+    eastl::array<int, 2> parents = { -1, -1 };
     for (int j = 0; j < tournamentSize; j++) {
-      int parentIndex = cx::generateRandomInt(
+      int parentIndex = generateRandomInt(
           chromosomeDistribution);
       if (j == 0 // Boolean short-circuit. Hehe.
-          || population[parentIndex].getFitness() < parents[0].getFitness()) {
+          || population[parentIndex].getFitness()
+             < population[parents[0]].getFitness()) {
         parents[1] = parents[0];
-        parents[0] = population[parentIndex];
-      } else if (parents[1].getNumBuildings() == 0 // Boolean short again.
+        parents[0] = parentIndex;
+      } else if (parents[1] == -1 // Boolean short again.
                  || population[parentIndex].getFitness()
-                    < parents[1].getFitness()) {
-        parents[1] = population[parentIndex];
+                    < population[parents[1]].getFitness()) {
+        parents[1] = parentIndex;
       }
     }
 
+    // Tournaments of one only pick one parent, which then mates with
+    // itself.
+    if (parents[1] == -1) {
+      parents[1] = parents[0];
+    }
+
     return parents;
   }
 
+  template <typename CrossoverPolicy, typename MutationPolicy>
   void GA::makeTwoParentsBreed(
       const Solution& parentA,
       const Solution& parentB,
@@ -377,49 +1720,28 @@ namespace bpt
       int& numOffsprings,
       const int numOffspringsToMake,
       const float mutationRate,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings,
-      const eastl::vector<eastl::vector<float>>& flowRates,
-      const eastl::vector<cx::NPolygon>& floodProneAreas,
-      const eastl::vector<cx::NPolygon>& landslideProneAreas,
-      const float floodProneAreaPenalty,
-      const float landslideProneAreaPenalty,
-      const float buildingDistanceWeight)
+      const Problem& problem)
   {
+    BPT_TRACE_SCOPE("breeding");
     std::uniform_real_distribution<float> mutationChanceDistribution{
         0.f, 1.f
     };
-    auto children = this->crossoverSolutions(parentA,
+    auto children = this->crossoverSolutions(CrossoverPolicy{},
+                                             parentA,
                                              parentB,
-                                             boundingArea,
-                                             inputBuildings);
+                                             problem);
     offsprings[numOffsprings] = children[0];
-    offsprings[numOffsprings].setFitness(this->getSolutionFitness(
-        offsprings[numOffsprings],
-        inputBuildings,
-        flowRates,
-        floodProneAreas,
-        landslideProneAreas,
-        floodProneAreaPenalty,
-        landslideProneAreaPenalty,
-        buildingDistanceWeight));
+    offsprings[numOffsprings].setFitness(this->computeSolutionFitness(
+        offsprings[numOffsprings], problem));
 
     // Mutation
-    float mutationProbability = cx::generateRandomReal(
+    float mutationProbability = generateRandomReal(
         mutationChanceDistribution);
     if (cx::floatLessThan(mutationProbability, mutationRate)) {
-      this->mutateSolution(offsprings[numOffsprings],
-                           boundingArea,
-                           inputBuildings);
-      offsprings[numOffsprings].setFitness(this->getSolutionFitness(
-          offsprings[numOffsprings],
-          inputBuildings,
-          flowRates,
-          floodProneAreas,
-          landslideProneAreas,
-          floodProneAreaPenalty,
-          landslideProneAreaPenalty,
-          buildingDistanceWeight));
+      this->mutateOffspring(MutationPolicy{},
+                            offsprings[numOffsprings],
+                            offsprings[numOffsprings].getFitness(),
+                            problem);
     }
 
     numOffsprings++;
@@ -432,7 +1754,7 @@ namespace bpt
       auto weakestSolutionIter = std::max_element(
           offsprings.begin(),
           offsprings.end(),
-          [](Solution solutionA, Solution solutionB) -> bool {
+          [](const Solution& solutionA, const Solution& solutionB) -> bool {
             return cx::floatLessThan(solutionA.getFitness(),
                                               solutionB.getFitness());
           }
@@ -444,232 +1766,559 @@ namespace bpt
                                                      weakestSolutionIter);
         offsprings[weakestSolutionIndex] = children[1];
         offsprings[weakestSolutionIndex].setFitness(
-            this->getSolutionFitness(
-                offsprings[weakestSolutionIndex],
-                inputBuildings,
-                flowRates,
-                floodProneAreas,
-                landslideProneAreas,
-                floodProneAreaPenalty,
-                landslideProneAreaPenalty,
-                buildingDistanceWeight));
-
-        float mutationProbability = cx::generateRandomReal(
+            this->computeSolutionFitness(
+                offsprings[weakestSolutionIndex], problem));
+
+        float mutationProbability = generateRandomReal(
             mutationChanceDistribution);
         if (cx::floatLessThan(mutationProbability, mutationRate)) {
-          this->mutateSolution(offsprings[weakestSolutionIndex],
-                               boundingArea,
-                               inputBuildings);
-          offsprings[weakestSolutionIndex].setFitness(
-              this->getSolutionFitness(
-                  offsprings[weakestSolutionIndex],
-                  inputBuildings,
-                  flowRates,
-                  floodProneAreas,
-                  landslideProneAreas,
-                  floodProneAreaPenalty,
-                  landslideProneAreaPenalty,
-                  buildingDistanceWeight));
+          this->mutateOffspring(
+              MutationPolicy{},
+              offsprings[weakestSolutionIndex],
+              offsprings[weakestSolutionIndex].getFitness(),
+              problem);
         }
       }
     } else {
       offsprings[numOffsprings] = children[1];
-      offsprings[numOffsprings].setFitness(this->getSolutionFitness(
-          offsprings[numOffsprings],
-          inputBuildings,
-          flowRates,
-          floodProneAreas,
-          landslideProneAreas,
-          floodProneAreaPenalty,
-          landslideProneAreaPenalty,
-          buildingDistanceWeight));
-
-      float mutationProbability = cx::generateRandomReal(
+      offsprings[numOffsprings].setFitness(this->computeSolutionFitness(
+          offsprings[numOffsprings], problem));
+
+      float mutationProbability = generateRandomReal(
           mutationChanceDistribution);
       if (cx::floatLessThan(mutationProbability, mutationRate)) {
-        this->mutateSolution(offsprings[numOffsprings],
-                             boundingArea,
-                             inputBuildings);
-        offsprings[numOffsprings].setFitness(this->getSolutionFitness(
-            offsprings[numOffsprings],
-            inputBuildings,
-            flowRates,
-            floodProneAreas,
-            landslideProneAreas,
-            floodProneAreaPenalty,
-            landslideProneAreaPenalty,
-            buildingDistanceWeight));
+        this->mutateOffspring(MutationPolicy{},
+                              offsprings[numOffsprings],
+                              offsprings[numOffsprings].getFitness(),
+                              problem);
       }
 
       numOffsprings++;
     }
   }
 
-  Solution
-  GA::generateRandomSolution(
-      const eastl::vector<InputBuilding>& inputBuildings,
-      const cx::NPolygon& boundingArea)
+  template <typename MutationPolicy>
+  void GA::finalizeOffspring(
+      Solution& offspring,
+      const double baselineFitness,
+      const float mutationRate,
+      const Problem& problem)
   {
-    float minX = std::min_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.x < ptB.x;
-        }
-    )->x;
-    float maxX = std::max_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.x < ptB.x;
+    std::uniform_real_distribution<float> mutationChanceDistribution{
+        0.f, 1.f
+    };
+    float mutationProbability = generateRandomReal(
+        mutationChanceDistribution);
+    if (cx::floatLessThan(mutationProbability, mutationRate)) {
+      this->mutateOffspring(MutationPolicy{},
+                            offspring,
+                            baselineFitness,
+                            problem);
+    } else {
+      offspring.setFitness(this->computeSolutionFitness(offspring, problem));
+    }
+  }
+
+  template <typename MutationPolicy>
+  void GA::mutateOffspring(MutationPolicy,
+                           Solution& offspring,
+                           const double,
+                           const Problem& problem)
+  {
+    this->mutateSolution(MutationPolicy{},
+                         offspring,
+                         problem);
+    offspring.setFitness(this->computeSolutionFitness(offspring, problem));
+  }
+
+  void GA::mutateOffspring(AdaptiveMutation,
+                           Solution& offspring,
+                           const double baselineFitness,
+                           const Problem& problem)
+  {
+    // The time spent includes that of the rejected, infeasible attempts.
+    const int mutationIndex = this->mutationSelector.selectOperator();
+    const auto startTime = std::chrono::steady_clock::now();
+    this->applyMutation(mutationIndex,
+                        offspring,
+                        problem);
+    const std::chrono::duration<double> mutationTime =
+        std::chrono::steady_clock::now() - startTime;
+
+    offspring.setFitness(this->computeSolutionFitness(offspring, problem));
+
+    this->mutationSelector.recordApplication(
+        mutationIndex,
+        std::max(0.0, baselineFitness - offspring.getFitness()),
+        mutationTime.count());
+  }
+
+  void GA::exchangeMigrants(
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum,
+      const Problem& problem)
+  {
+    BPT_TRACE_SCOPE("migration");
+    // Send copies of our best solutions.
+    eastl::vector<int> populationOrder(population.size());
+    std::iota(populationOrder.begin(), populationOrder.end(), 0);
+
+    const int numMigrants = std::min(this->island->getNumMigrants(),
+                                     static_cast<int>(population.size()));
+    std::partial_sort(
+        populationOrder.begin(),
+        populationOrder.begin() + numMigrants,
+        populationOrder.end(),
+        [&population](int solutionA, int solutionB) {
+          return cx::floatLessThan(population[solutionA].getFitness(),
+                                   population[solutionB].getFitness());
         }
-    )->x;
-    float minY = std::min_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.y < ptB.y;
+    );
+
+    eastl::vector<Solution> emigrants;
+    for (int i = 0; i < numMigrants; i++) {
+      emigrants.push_back(population[populationOrder[i]]);
+      emigrants.back().clearFootprintCache();
+    }
+
+    this->island->sendMigrants(emigrants);
+
+    // Islands may not have been given the exact same problem, so migrants
+    // are checked and evaluated again before being let in.
+    const int numBuildings = static_cast<int>(problem.inputBuildings.size());
+    for (const Solution& migrant : this->island->receiveMigrants()) {
+      if (migrant.getNumBuildings() != numBuildings) {
+        continue;
+      }
+
+      Solution immigrant = this->importSolution(migrant, problem);
+      if (!this->isSolutionAllowed(immigrant, problem)) {
+        continue;
+      }
+
+      immigrant.setFitness(this->computeSolutionFitness(immigrant, problem));
+      if (this->replacementType == ReplacementType::STEADY_STATE) {
+        this->replaceWorstSolution(immigrant,
+                                   population,
+                                   populationHeap,
+                                   fitnessSum);
+      } else {
+        auto worstSolutionIter = std::max_element(
+            population.begin(),
+            population.end(),
+            [](const Solution& solutionA, const Solution& solutionB) {
+              return cx::floatLessThan(solutionA.getFitness(),
+                                       solutionB.getFitness());
+            }
+        );
+        if (cx::floatLessThan(immigrant.getFitness(),
+                              worstSolutionIter->getFitness())) {
+          *worstSolutionIter = eastl::move(immigrant);
         }
-    )->y;
-    float maxY = std::max_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.y < ptB.y;
+      }
+    }
+  }
+
+  void GA::replaceWorstSolution(
+      Solution& offspring,
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum)
+  {
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::REPLACEMENT };
+    const PopulationEntry& worstEntry = populationHeap.getMax();
+    if (!cx::floatLessThan(offspring.getFitness(), worstEntry.fitness)) {
+      return;
+    }
+
+    const int solutionIndex = worstEntry.solutionIndex;
+    fitnessSum += offspring.getFitness() - worstEntry.fitness;
+    populationHeap.replaceMax(PopulationEntry{ offspring.getFitness(),
+                                               solutionIndex });
+    population[solutionIndex] = eastl::move(offspring);
+  }
+
+  Solution GA::createEmptySolution(const Problem& problem)
+  {
+    const int numBuildings = static_cast<int>(problem.inputBuildings.size());
+    if (this->geneEncoding == GeneEncoding::COMPACT) {
+      const SiteBoundary& boundingArea = problem.boundingArea;
+      return Solution{ numBuildings,
+                       GeneQuantizer{ boundingArea.getMinX(),
+                                      boundingArea.getMinY(),
+                                      boundingArea.getMaxX(),
+                                      boundingArea.getMaxY() } };
+    }
+
+    return Solution{ numBuildings };
+  }
+
+  Solution GA::importSolution(const Solution& solution,
+                              const Problem& problem)
+  {
+    Solution importedSolution = this->createEmptySolution(problem);
+    for (int i = 0; i < solution.getNumBuildings(); i++) {
+      importedSolution.setBuildingXPos(i, solution.getBuildingXPos(i));
+      importedSolution.setBuildingYPos(i, solution.getBuildingYPos(i));
+      importedSolution.setBuildingRotation(
+          i, problem.footprintTable.snapRotation(
+                 solution.getBuildingRotation(i)));
+    }
+
+    return importedSolution;
+  }
+
+  void GA::generateInitialPopulation(
+      eastl::vector<Solution>& population,
+      const eastl::vector<Solution>& seedSolutions,
+      const bool areSeedsScored,
+      const Problem& problem)
+  {
+    BPT_TRACE_SCOPE("initialPopulation");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::INITIAL_POPULATION };
+    const int numBuildings = static_cast<int>(problem.inputBuildings.size());
+    const int populationSize = static_cast<int>(population.size());
+
+    int numSeeds = 0;
+    for (const Solution& seedSolution : seedSolutions) {
+      if (numSeeds == populationSize) {
+        break;
+      }
+
+      if (seedSolution.getNumBuildings() != numBuildings) {
+        continue;
+      }
+
+      if (areSeedsScored) {
+        population[numSeeds] = seedSolution;
+        numSeeds++;
+        continue;
+      }
+
+      Solution solution = this->importSolution(seedSolution, problem);
+      if (!this->isSolutionAllowed(solution, problem)
+          && !this->repairSolution(solution, problem)) {
+        continue;
+      }
+
+      population[numSeeds] = eastl::move(solution);
+      numSeeds++;
+    }
+
+    // Alternate between perturbed copies of the seeds, to search around
+    // them, and random solutions, to keep the population diverse.
+    this->resetInitializationSequences(problem);
+    for (int i = numSeeds; i < populationSize; i++) {
+      if (numSeeds > 0 && (i - numSeeds) % 2 == 0) {
+        population[i] = population[(i - numSeeds) / 2 % numSeeds];
+        this->mutateSolution(RandomMutation{}, population[i], problem);
+      } else {
+        population[i] = this->generateRandomSolution(problem);
+      }
+    }
+
+    for (int i = areSeedsScored ? numSeeds : 0; i < populationSize; i++) {
+      population[i].setFitness(
+          this->computeSolutionFitness(population[i], problem));
+    }
+  }
+
+  bool GA::repairSolution(Solution& solution, const Problem& problem)
+  {
+    constexpr int numAttemptsPerBuilding = 50;
+
+    const SiteBoundary& boundingArea = problem.boundingArea;
+    const float siteSize = std::max(
+        boundingArea.getMaxX() - boundingArea.getMinX(),
+        boundingArea.getMaxY() - boundingArea.getMinY());
+    const int numBuildings = solution.getNumBuildings();
+
+    auto isBuildingOffending = [&](int buildingIndex) -> bool {
+      const Footprint& building = solution.getBuildingFootprint(
+          buildingIndex, problem.footprintTable);
+      if (!boundingArea.isFootprintWithin(building)) {
+        return true;
+      }
+
+      for (int i = 0; i < numBuildings; i++) {
+        if (i != buildingIndex
+            && areFootprintsIntersecting(
+                building,
+                solution.getBuildingFootprint(i, problem.footprintTable))) {
+          return true;
         }
-    )->y;
+      }
+
+      return false;
+    };
+
+    // Move each offending building in turn, searching further and further
+    // away from where it was placed.
+    std::normal_distribution<float> offsetDistribution{ 0.f, 1.f };
+    for (int i = 0; i < numBuildings; i++) {
+      if (!isBuildingOffending(i)) {
+        continue;
+      }
+
+      const float origXPos = solution.getBuildingXPos(i);
+      const float origYPos = solution.getBuildingYPos(i);
+      const float origRotation = solution.getBuildingRotation(i);
+
+      bool isRepaired = false;
+      for (int j = 0; j < numAttemptsPerBuilding && !isRepaired; j++) {
+        const float searchRadius = siteSize
+                                   * static_cast<float>(j + 1)
+                                   / numAttemptsPerBuilding;
+        solution.setBuildingXPos(
+            i, origXPos + (offsetDistribution(getRandomEngine())
+                           * searchRadius));
+        solution.setBuildingYPos(
+            i, origYPos + (offsetDistribution(getRandomEngine())
+                           * searchRadius));
+        solution.setBuildingRotation(
+            i, (j % 2 == 0) ? origRotation
+                            : this->generateRandomRotation(problem));
+        isRepaired = !isBuildingOffending(i);
+      }
+
+      if (!isRepaired) {
+        return false;
+      }
+    }
+
+    return this->isSolutionFeasible(solution, problem);
+  }
+
+  bool GA::insertBuilding(Solution& solution,
+                          const int buildingIndex,
+                          const Problem& problem)
+  {
+    constexpr int numAttempts = 1000;
+
+    const SiteBoundary& boundingArea = problem.boundingArea;
+    std::uniform_real_distribution<float> xPosDistribution{
+        boundingArea.getMinX(), boundingArea.getMaxX()
+    };
+    std::uniform_real_distribution<float> yPosDistribution{
+        boundingArea.getMinY(), boundingArea.getMaxY()
+    };
+
+    for (int i = 0; i < numAttempts; i++) {
+      solution.setBuildingXPos(buildingIndex,
+                               generateRandomReal(xPosDistribution));
+      solution.setBuildingYPos(buildingIndex,
+                               generateRandomReal(yPosDistribution));
+      solution.setBuildingRotation(buildingIndex,
+                                   this->generateRandomRotation(problem));
+
+      const Footprint& building = solution.getBuildingFootprint(
+          buildingIndex, problem.footprintTable);
+      if (!boundingArea.isFootprintWithin(building)) {
+        continue;
+      }
+
+      bool isOverlapping = false;
+      for (int j = 0; j < buildingIndex && !isOverlapping; j++) {
+        isOverlapping = areFootprintsIntersecting(
+            building,
+            solution.getBuildingFootprint(j, problem.footprintTable));
+      }
+
+      if (!isOverlapping) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void GA::resetInitializationSequences(const Problem& problem)
+  {
+    this->initializationSequences.clear();
+    if (this->initializationType == InitializationType::SCRAMBLED_HALTON) {
+      for (int i = 0; i < problem.inputBuildings.size(); i++) {
+        this->initializationSequences.push_back(ScrambledHaltonSequence{ 3 });
+      }
+    }
+  }
+
+  Solution
+  GA::generateRandomSolution(const Problem& problem)
+  {
+    const SiteBoundary& boundingArea = problem.boundingArea;
+    const FootprintTable& footprintTable = problem.footprintTable;
+    float minX = boundingArea.getMinX();
+    float maxX = boundingArea.getMaxX();
+    float minY = boundingArea.getMinY();
+    float maxY = boundingArea.getMaxY();
 
     std::uniform_real_distribution<float> xPosDistribution{ minX, maxX };
     std::uniform_real_distribution<float> yPosDistribution{ minY, maxY };
-    std::uniform_real_distribution<float> rotationDistribution{ 0.f, 360.f };
 
-    Solution solution{ static_cast<int>(inputBuildings.size()) };
+    const int numBuildings = static_cast<int>(problem.inputBuildings.size());
+    const bool isQuasiRandom = !this->initializationSequences.empty();
+    assert(!isQuasiRandom
+           || this->initializationSequences.size() == numBuildings);
+
+    Solution solution = this->createEmptySolution(problem);
     do {
-      for (int i = 0; i < inputBuildings.size(); i++) {
+      for (int i = 0; i < numBuildings; i++) {
         cx::Point buildingPos { 0.f, 0.f };
         float buildingRotation = 0.f;
-        cx::Rectangle buildingRect {
-            buildingPos.x,
-            buildingPos.y,
-            inputBuildings[i].width,
-            inputBuildings[i].length,
-            buildingRotation
-        };
         do {
-          buildingPos.x = cx::generateRandomReal(xPosDistribution);
-          buildingPos.y = cx::generateRandomReal(yPosDistribution);
-          buildingRotation = cx::generateRandomReal(
-              rotationDistribution);
-          buildingRect.x = buildingPos.x;
-          buildingRect.y = buildingPos.y;
-          buildingRect.angle = buildingRotation;
-        } while (!isRectWithinNPolygon(buildingRect, boundingArea));
+          if (isQuasiRandom) {
+            // Points are mapped into the site AABB, and the ones outside of
+            // the site are skipped by the feasibility checks.
+            float point[3];
+            this->initializationSequences[i].generateNextPoint(point);
+            buildingPos.x = minX + (point[0] * (maxX - minX));
+            buildingPos.y = minY + (point[1] * (maxY - minY));
+            if (footprintTable.hasOrientations()) {
+              const int numOrientations = footprintTable.getNumOrientations();
+              const int orientationIndex = std::min(
+                  static_cast<int>(point[2] * numOrientations),
+                  numOrientations - 1);
+              buildingRotation = footprintTable.getOrientation(
+                  orientationIndex);
+            } else {
+              buildingRotation = point[2] * 360.f;
+            }
+          } else {
+            buildingPos.x = generateRandomReal(xPosDistribution);
+            buildingPos.y = generateRandomReal(yPosDistribution);
+            buildingRotation = this->generateRandomRotation(problem);
+          }
+        } while (!boundingArea.isFootprintWithin(
+                    footprintTable.getFootprint(i,
+                                                buildingPos.x,
+                                                buildingPos.y,
+                                                buildingRotation)));
 
         solution.setBuildingXPos(i, buildingPos.x);
         solution.setBuildingYPos(i, buildingPos.y);
         solution.setBuildingRotation(i, buildingRotation);
       }
-    } while (!this->isSolutionFeasible(solution, boundingArea, inputBuildings));
+    } while (!this->isSolutionAllowed(solution, problem));
 
     return solution;
   }
 
+  float GA::generateRandomRotation(const Problem& problem)
+  {
+    const FootprintTable& footprintTable = problem.footprintTable;
+    if (footprintTable.hasOrientations()) {
+      std::uniform_int_distribution<int> orientationDistrib{
+          0, footprintTable.getNumOrientations() - 1
+      };
+      return footprintTable.getOrientation(
+          generateRandomInt(orientationDistrib));
+    }
+
+    std::uniform_real_distribution<float> rotationDistribution{ 0.f, 360.f };
+    return generateRandomReal(rotationDistribution);
+  }
+
   eastl::array<Solution, 2>
-  GA::crossoverSolutions(const Solution& solutionA,
+  GA::crossoverSolutions(UniformCrossover,
+                         const Solution& solutionA,
                          const Solution& solutionB,
-                         const cx::NPolygon& boundingArea,
-                         const eastl::vector<InputBuilding>& inputBuildings)
+                         const Problem& problem)
   {
+    BPT_TRACE_SCOPE("crossover");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::CROSSOVER };
     // We're doing uniform crossover.
     std::uniform_int_distribution<int> parentDistrib{0, 1 };
     int numBuildings = solutionA.getNumBuildings();
 
     // Prevent unnecessary copying of the parents.
     eastl::array<const Solution* const, 2> parents{ &solutionA, &solutionB };
-    eastl::array<
-    eastl::function<void(Solution&, const Solution&, const int)>,
-    3> solutionFuncs = {
-        [](Solution& solution,
-           const Solution& source,
-           const int buildingIndex) -> void {
-          solution.setBuildingXPos(buildingIndex,
-                                   source.getBuildingXPos(buildingIndex));
-        },
-        [](Solution& solution,
-           const Solution& source,
-           const int buildingIndex) -> void {
-          solution.setBuildingYPos(buildingIndex,
-                                   source.getBuildingYPos(buildingIndex));
-        },
-        [](Solution& solution,
-           const Solution& source,
-           const int buildingIndex) -> void {
-          solution.setBuildingRotation(
-              buildingIndex,
-              source.getBuildingRotation(buildingIndex));
-        }
-    };
 
+    // Each child starts off as a copy of one parent, so only the buildings
+    // that got genes of the other parent need to be checked.
     eastl::array<Solution, 2> children{ solutionA, solutionB };
+    eastl::vector<int> modifiedBuildings;
     for (int childIdx = 0; childIdx < children.size(); childIdx++) {
+      const Solution& baseParent = *parents[childIdx];
       do {
+        Solution& child = children[childIdx];
+        modifiedBuildings.clear();
         for (int i = 0; i < numBuildings; i++) {
-          for (auto& f : solutionFuncs) {
-            int parentIdx = cx::generateRandomInt(parentDistrib);
-            f(children[childIdx], *parents[parentIdx], i);
+          const Solution* xPosSource = parents[generateRandomInt(
+              parentDistrib)];
+          const Solution* yPosSource = parents[generateRandomInt(
+              parentDistrib)];
+          const Solution* rotationSource = parents[generateRandomInt(
+              parentDistrib)];
+          child.setBuildingXPos(i, xPosSource->getBuildingXPos(i));
+          child.setBuildingYPos(i, yPosSource->getBuildingYPos(i));
+          child.setBuildingRotation(i,
+                                    rotationSource->getBuildingRotation(i));
+
+          if (child.getBuildingXPos(i) != baseParent.getBuildingXPos(i)
+              || child.getBuildingYPos(i) != baseParent.getBuildingYPos(i)
+              || child.getBuildingRotation(i)
+                 != baseParent.getBuildingRotation(i)) {
+            modifiedBuildings.push_back(i);
           }
         }
-      } while (!this->isSolutionFeasible(children[childIdx],
-                                         boundingArea,
-                                         inputBuildings));
+      } while (!this->isSolutionAllowed(children[childIdx],
+                                        modifiedBuildings,
+                                        problem));
     }
 
     return children;
   }
 
-  void GA::mutateSolution(Solution& solution,
-                          const cx::NPolygon& boundingArea,
-                          const eastl::vector<InputBuilding>& inputBuildings)
+  void GA::mutateSolution(RandomMutation,
+                          Solution& solution,
+                          const Problem& problem)
   {
-    eastl::array<eastl::function<void(Solution&,
-    const cx::NPolygon&,
-    const eastl::vector<InputBuilding>&)>,
-    3> mutationFunctions = {
-        [this](Solution& solution,
-               const cx::NPolygon& boundingArea,
-               const eastl::vector<InputBuilding>& inputBuildings)
-        {
-          this->applyBuddyBuddyMutation(solution, boundingArea, inputBuildings);
-        },
-        [this](Solution& solution,
-               const cx::NPolygon& boundingArea,
-               const eastl::vector<InputBuilding>& inputBuildings)
-        {
-          this->applyShakingMutation(solution, boundingArea, inputBuildings);
-        },
-        [this](Solution& solution,
-               const cx::NPolygon& boundingArea,
-               const eastl::vector<InputBuilding>& inputBuildings)
-        {
-          this->applyJiggleMutation(solution, boundingArea, inputBuildings);
-        }
+    std::uniform_int_distribution<int> numMutationsDistrib{
+        0, numMutations - 1
     };
+    this->applyMutation(generateRandomInt(numMutationsDistrib),
+                        solution,
+                        problem);
+  }
 
-    std::uniform_int_distribution<const int> numMutationsDistrib{
-        0, static_cast<int>(mutationFunctions.size() - 1)
-    };
-    const int mutationFuncIndex = cx::generateRandomInt(
-        numMutationsDistrib);
-    mutationFunctions[mutationFuncIndex](solution,
-                                         boundingArea,
-                                         inputBuildings);
+  void GA::applyMutation(const int mutationIndex,
+                         Solution& solution,
+                         const Problem& problem)
+  {
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::MUTATION };
+    switch (mutationIndex) {
+      case 0:
+        this->mutateSolution(BuddyBuddyMutation{},
+                             solution,
+                             problem);
+        break;
+      case 1:
+        this->mutateSolution(ShakingMutation{},
+                             solution,
+                             problem);
+        break;
+      case 2:
+        this->mutateSolution(JiggleMutation{},
+                             solution,
+                             problem);
+        break;
+      default:
+        break;
+    }
   }
 
-  void GA::applyBuddyBuddyMutation(
+  void GA::mutateSolution(
+      BuddyBuddyMutation,
       Solution& solution,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
+    BPT_TRACE_SCOPE("buddyBuddyMutation");
+    const eastl::vector<InputBuilding>& inputBuildings = problem.inputBuildings;
     std::uniform_int_distribution<int> buildingDistrib{
         0, static_cast<int>(inputBuildings.size() - 1)
     };
@@ -678,6 +2327,7 @@ namespace bpt
     std::uniform_real_distribution<float> normalizedDistrib{ 0, 1 };
 
     Solution tempSolution;
+    eastl::vector<int> modifiedBuildings(1);
     do {
       tempSolution = solution;
 
@@ -685,46 +2335,41 @@ namespace bpt
       int staticBuddy = 0;
       int dynamicBuddy = 0; // The buddy to be moved.
       do {
-        staticBuddy = cx::generateRandomInt(buildingDistrib);
-        dynamicBuddy = cx::generateRandomInt(buildingDistrib);
+        staticBuddy = generateRandomInt(buildingDistrib);
+        dynamicBuddy = generateRandomInt(buildingDistrib);
       } while (staticBuddy == dynamicBuddy);
 
-      auto staticBuddyRect = cx::Rectangle{
-          solution.getBuildingXPos(staticBuddy),
-          solution.getBuildingYPos(staticBuddy),
-          inputBuildings[staticBuddy].width,
-          inputBuildings[staticBuddy].length,
-          solution.getBuildingRotation(staticBuddy)
-      };
-      auto buddyPoly = cx::convertRectangleToPolygon(staticBuddyRect);
+      const Footprint& buddyFootprint = solution.getBuildingFootprint(
+          staticBuddy, problem.footprintTable);
+      const auto& buddyCorners = buddyFootprint.corners;
 
-      const int buddySide = cx::generateRandomInt(
+      const int buddySide = generateRandomInt(
           buddySideDistrib);
 
       cx::Line contactLine;
       switch (buddySide) {
         case 0:
           contactLine = cx::Line{
-              { buddyPoly.vertices[0].x, buddyPoly.vertices[0].y },
-              { buddyPoly.vertices[1].x, buddyPoly.vertices[1].y }
+              { buddyCorners[0].x, buddyCorners[0].y },
+              { buddyCorners[1].x, buddyCorners[1].y }
           };
           break;
         case 1:
           contactLine = cx::Line{
-              { buddyPoly.vertices[1].x, buddyPoly.vertices[1].y },
-              { buddyPoly.vertices[2].x, buddyPoly.vertices[2].y }
+              { buddyCorners[1].x, buddyCorners[1].y },
+              { buddyCorners[2].x, buddyCorners[2].y }
           };
           break;
         case 2:
           contactLine = cx::Line{
-              { buddyPoly.vertices[2].x, buddyPoly.vertices[2].y },
-              { buddyPoly.vertices[3].x, buddyPoly.vertices[3].y }
+              { buddyCorners[2].x, buddyCorners[2].y },
+              { buddyCorners[3].x, buddyCorners[3].y }
           };
           break;
         case 3:
           contactLine = cx::Line{
-              { buddyPoly.vertices[3].x, buddyPoly.vertices[3].y },
-              { buddyPoly.vertices[0].x, buddyPoly.vertices[0].y }
+              { buddyCorners[3].x, buddyCorners[3].y },
+              { buddyCorners[0].x, buddyCorners[0].y }
           };
           break;
         default:
@@ -732,7 +2377,7 @@ namespace bpt
       }
 
       auto contactLineVec = cx::lineToVec(contactLine);
-      const int orientation = cx::generateRandomInt(
+      const int orientation = generateRandomInt(
           relOrientationDistrib);
       float distContactToBuddyCenter = 0.f;
 
@@ -768,7 +2413,7 @@ namespace bpt
           cx::Vec2{ 0.f, -extLength }, contactLineAngle)
                                            + contactLine.start;
 
-      const float lineWidthModifier = cx::generateRandomReal(
+      const float lineWidthModifier = generateRandomReal(
           normalizedDistrib);
 
       cx::Point dynamicBuddyPos{
@@ -782,246 +2427,213 @@ namespace bpt
 
       tempSolution.setBuildingXPos(dynamicBuddy, dynamicBuddyPos.x);
       tempSolution.setBuildingYPos(dynamicBuddy, dynamicBuddyPos.y);
-      tempSolution.setBuildingRotation(dynamicBuddy, dynamicBuddyAngle);
-    } while (!this->isSolutionFeasible(tempSolution,
-                                       boundingArea,
-                                       inputBuildings));
+      tempSolution.setBuildingRotation(
+          dynamicBuddy,
+          problem.footprintTable.snapRotation(dynamicBuddyAngle));
+      modifiedBuildings[0] = dynamicBuddy;
+    } while (!this->isSolutionAllowed(tempSolution,
+                                      modifiedBuildings,
+                                      problem));
     solution = tempSolution;
   }
 
-  void GA::applyShakingMutation(
+  void GA::mutateSolution(
+      ShakingMutation,
       Solution& solution,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
+    BPT_TRACE_SCOPE("shakingMutation");
     std::uniform_int_distribution<int> geneDistribution{
         0, solution.getNumBuildings() - 1
     };
 
-    int targetGeneIndex = cx::generateRandomInt(geneDistribution);
+    int targetGeneIndex = generateRandomInt(geneDistribution);
 
-    float minX = std::min_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.x < ptB.x;
-        }
-    )->x;
-    float maxX = std::max_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.x < ptB.x;
-        }
-    )->x;
-    float minY = std::min_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.y < ptB.y;
-        }
-    )->y;
-    float maxY = std::max_element(
-        boundingArea.vertices.begin(),
-        boundingArea.vertices.end(),
-        [](cx::Point ptA, cx::Point ptB) -> bool {
-          return ptA.y < ptB.y;
-        }
-    )->y;
+    float minX = problem.boundingArea.getMinX();
+    float maxX = problem.boundingArea.getMaxX();
+    float minY = problem.boundingArea.getMinY();
+    float maxY = problem.boundingArea.getMaxY();
 
     std::uniform_real_distribution<float> xPosDistribution{ minX, maxX };
     std::uniform_real_distribution<float> yPosDistribution{ minY, maxY };
-    std::uniform_real_distribution<float> rotationDistribution{ 0.f, 360.f };
 
+    const eastl::vector<int> modifiedBuildings{ targetGeneIndex };
     Solution tempSolution = solution;
     do {
-      float newXPos = cx::generateRandomReal(xPosDistribution);
-      float newYPos = cx::generateRandomReal(yPosDistribution);
-      float newRotation = cx::generateRandomReal(rotationDistribution);
+      float newXPos = generateRandomReal(xPosDistribution);
+      float newYPos = generateRandomReal(yPosDistribution);
+      float newRotation = this->generateRandomRotation(problem);
 
       tempSolution.setBuildingXPos(targetGeneIndex, newXPos);
       tempSolution.setBuildingYPos(targetGeneIndex, newYPos);
       tempSolution.setBuildingRotation(targetGeneIndex, newRotation);
-    } while (!this->isSolutionFeasible(tempSolution,
-                                       boundingArea,
-                                       inputBuildings));
+    } while (!this->isSolutionAllowed(tempSolution,
+                                      modifiedBuildings,
+                                      problem));
 
     solution = tempSolution;
   }
 
-  void GA::applyJiggleMutation(
+  void GA::mutateSolution(
+      JiggleMutation,
       Solution& solution,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
+    BPT_TRACE_SCOPE("jiggleMutation");
+    constexpr float maxShiftAmount = 1.f;
+    constexpr float maxRotShiftAmount = 5.f;
+    std::uniform_real_distribution<float> shiftDistrib{ 0, maxShiftAmount };
+    std::uniform_int_distribution<int> buildingIndexDistrib{
+        0, static_cast<int>(problem.inputBuildings.size() - 1)
+    };
+    std::uniform_real_distribution<float> rotShiftDistrib{
+        -maxRotShiftAmount,
+        maxRotShiftAmount
+    };
+
+    // With allowed orientations, a building is instead rotated to one of the
+    // orientations next to its current one, or kept as is.
+    const FootprintTable& footprintTable = problem.footprintTable;
+    std::uniform_int_distribution<int> orientationShiftDistrib{ -1, 1 };
+
+    // Directions the building can be moved to, as the signs of the shifts
+    // along the x and y axes. NOTE: The origin is on the top left corner.
+    constexpr int numMovements = 8;
+    constexpr eastl::array<eastl::array<int, 2>, numMovements> movements = {{
+        {{  1,  0 }},
+        {{ -1,  0 }},
+        {{  0, -1 }},
+        {{  0,  1 }},
+        {{  1, -1 }},
+        {{  1,  1 }},
+        {{ -1, -1 }},
+        {{ -1,  1 }}
+    }};
+    std::uniform_int_distribution<int> movementDistrib{ 0, numMovements - 1 };
+
     Solution tempSolution;
+    eastl::vector<int> modifiedBuildings(1);
     do {
       tempSolution = solution;
 
-      constexpr int numMovements = 8;
-      constexpr float maxShiftAmount = 1.f;
-      constexpr float maxRotShiftAmount = 5.f;
-      std::uniform_real_distribution<float> shiftDistrib{ 0, maxShiftAmount };
-      std::uniform_int_distribution<int> buildingIndexDistrib{
-          0, static_cast<int>(inputBuildings.size() - 1)
-      };
-      std::uniform_real_distribution<float> rotShiftDistrib{
-          -maxRotShiftAmount,
-          maxRotShiftAmount
-      };
-      static const
-      eastl::array<eastl::function<Solution(Solution, int)>,
-          numMovements> jiggleFunctions = {
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmount = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     + shiftAmount);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmount = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     - shiftAmount);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmount = cx::generateRandomReal(shiftDistrib);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     - shiftAmount);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmount = cx::generateRandomReal(shiftDistrib);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     + shiftAmount);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmountA = cx::generateRandomReal(shiftDistrib);
-            float shiftAmountB = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     + shiftAmountA);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingYPos(buildingIndex)
-                                     - shiftAmountB);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmountA = cx::generateRandomReal(shiftDistrib);
-            float shiftAmountB = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     + shiftAmountA);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingYPos(buildingIndex)
-                                     + shiftAmountB);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmountA = cx::generateRandomReal(shiftDistrib);
-            float shiftAmountB = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     - shiftAmountA);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingYPos(buildingIndex)
-                                     - shiftAmountB);
-            return solution;
-          },
-          [&shiftDistrib](Solution solution, int buildingIndex) -> Solution
-          {
-            float shiftAmountA = cx::generateRandomReal(shiftDistrib);
-            float shiftAmountB = cx::generateRandomReal(shiftDistrib);
-            solution.setBuildingXPos(buildingIndex,
-                                     solution.getBuildingXPos(buildingIndex)
-                                     + shiftAmountA);
-
-            // NOTE: The origin is on the top left corner.
-            solution.setBuildingYPos(buildingIndex,
-                                     solution.getBuildingYPos(buildingIndex)
-                                     + shiftAmountB);
-            return solution;
-          }
-      };
-      std::uniform_int_distribution<int> jiggleFuncDistrib{
-          0, static_cast<int>(jiggleFunctions.size() - 1)
-      };
-
-      const int targetBuildingIndex = cx::generateRandomInt(
+      const int targetBuildingIndex = generateRandomInt(
           buildingIndexDistrib);
-      const int jiggleFuncIndex = cx::generateRandomInt(
-          jiggleFuncDistrib);
+      const auto& movement = movements[generateRandomInt(movementDistrib)];
+
+      if (movement[0] != 0) {
+        const float shiftAmount = generateRandomReal(shiftDistrib);
+        tempSolution.setBuildingXPos(
+            targetBuildingIndex,
+            tempSolution.getBuildingXPos(targetBuildingIndex)
+            + (movement[0] * shiftAmount));
+      }
+
+      if (movement[1] != 0) {
+        const float shiftAmount = generateRandomReal(shiftDistrib);
+        tempSolution.setBuildingYPos(
+            targetBuildingIndex,
+            tempSolution.getBuildingYPos(targetBuildingIndex)
+            + (movement[1] * shiftAmount));
+      }
 
-      tempSolution = jiggleFunctions[jiggleFuncIndex](tempSolution,
-                                                      targetBuildingIndex);
+      const float rot = tempSolution.getBuildingRotation(targetBuildingIndex);
+      float newRot = 0.f;
+      if (footprintTable.hasOrientations()) {
+        const int numOrientations = footprintTable.getNumOrientations();
+        const int orientationIndex =
+            (footprintTable.findNearestOrientationIndex(rot)
+             + generateRandomInt(orientationShiftDistrib)
+             + numOrientations) % numOrientations;
+        newRot = footprintTable.getOrientation(orientationIndex);
+      } else {
+        newRot = rot + generateRandomReal(rotShiftDistrib);
+      }
 
-      const float rotDelta = cx::generateRandomReal(rotShiftDistrib);
-      const float newRot = tempSolution.getBuildingRotation(targetBuildingIndex)
-                           + rotDelta;
       tempSolution.setBuildingRotation(targetBuildingIndex, newRot);
-    } while (!this->isSolutionFeasible(tempSolution,
-                                       boundingArea,
-                                       inputBuildings));
+      modifiedBuildings[0] = targetBuildingIndex;
+    } while (!this->isSolutionAllowed(tempSolution,
+                                      modifiedBuildings,
+                                      problem));
 
     solution = tempSolution;
   }
 
   bool GA::isSolutionFeasible(
       const Solution& solution,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
-    return this->doesSolutionHaveNoBuildingsOverlapping(solution,
-                                                        inputBuildings)
+    BPT_TRACE_SCOPE("feasibility");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::FEASIBILITY };
+    return this->doesSolutionHaveNoBuildingsOverlapping(solution, problem)
            && this->areSolutionBuildingsWithinBounds(solution,
-                                                     boundingArea,
-                                                     inputBuildings);
+                                                     problem);
+  }
+
+  bool GA::isSolutionFeasible(
+      const Solution& solution,
+      const eastl::vector<int>& modifiedBuildings,
+      const Problem& problem)
+  {
+    BPT_TRACE_SCOPE("feasibility");
+    PerfPhaseScope perfPhaseScope{ this->perfCounters.get(),
+                                   GAPhase::FEASIBILITY };
+    for (const int i : modifiedBuildings) {
+      const Footprint& building0 = solution.getBuildingFootprint(
+          i, problem.footprintTable);
+      if (!problem.boundingArea.isFootprintWithin(building0)) {
+        return false;
+      }
+    }
+
+    for (const int i : modifiedBuildings) {
+      const Footprint& building0 = solution.getBuildingFootprint(
+          i, problem.footprintTable);
+      for (int j = 0; j < solution.getNumBuildings(); j++) {
+        if (j == i) {
+          continue;
+        }
+
+        const Footprint& building1 = solution.getBuildingFootprint(
+            j, problem.footprintTable);
+        if (areFootprintsIntersecting(building0, building1)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool GA::isSolutionAllowed(
+      const Solution& solution,
+      const Problem& problem)
+  {
+    return this->isCurrRunPenalized
+           || this->isSolutionFeasible(solution, problem);
+  }
+
+  bool GA::isSolutionAllowed(
+      const Solution& solution,
+      const eastl::vector<int>& modifiedBuildings,
+      const Problem& problem)
+  {
+    return this->isCurrRunPenalized
+           || this->isSolutionFeasible(solution, modifiedBuildings, problem);
   }
 
   bool GA::doesSolutionHaveNoBuildingsOverlapping(
       const Solution& solution,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
     for (int i = 0; i < solution.getNumBuildings(); i++) {
-      cx::Rectangle building0 = cx::Rectangle{
-          solution.getBuildingXPos(i),
-          solution.getBuildingYPos(i),
-          inputBuildings[i].width,
-          inputBuildings[i].length,
-          solution.getBuildingRotation(i)
-      };
+      const Footprint& building0 = solution.getBuildingFootprint(
+          i, problem.footprintTable);
 
       for (int j = i + 1; j < solution.getNumBuildings(); j++) {
-        cx::Rectangle building1 = cx::Rectangle{
-            solution.getBuildingXPos(j),
-            solution.getBuildingYPos(j),
-            inputBuildings[j].width,
-            inputBuildings[j].length,
-            solution.getBuildingRotation(j)
-        };
-        if (cx::areTwoRectsIntersecting(building0, building1)) {
+        const Footprint& building1 = solution.getBuildingFootprint(
+            j, problem.footprintTable);
+        if (areFootprintsIntersecting(building0, building1)) {
           return false;
         }
       }
@@ -1032,23 +2644,39 @@ namespace bpt
 
   bool GA::areSolutionBuildingsWithinBounds(
       const Solution& solution,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings)
+      const Problem& problem)
   {
     for (int i = 0; i < solution.getNumBuildings(); i++) {
-      cx::Rectangle buildingRect = cx::Rectangle{
-          solution.getBuildingXPos(i),
-          solution.getBuildingYPos(i),
-          inputBuildings[i].width,
-          inputBuildings[i].length,
-          solution.getBuildingRotation(i)
-      };
-
-      if (!cx::isRectWithinNPolygon(buildingRect, boundingArea)) {
+      const Footprint& building = solution.getBuildingFootprint(
+          i, problem.footprintTable);
+      if (!problem.boundingArea.isFootprintWithin(building)) {
         return false;
       }
     }
 
     return true;
   }
+
+  void GA::releaseFootprintCaches(eastl::vector<Solution>& population)
+  {
+    if (this->geneEncoding != GeneEncoding::COMPACT) {
+      return;
+    }
+
+    for (Solution& solution : population) {
+      solution.clearFootprintCache();
+    }
+  }
+
+  void GA::addPopulationToHistory(
+      eastl::vector<eastl::vector<Solution>>& history,
+      const eastl::vector<Solution>& population)
+  {
+    // The footprint caches are only useful while a solution is still being
+    // evolved, so don't keep them around in the history.
+    history.push_back(population);
+    for (Solution& solution : history.back()) {
+      solution.clearFootprintCache();
+    }
+  }
 }
@@ -1,19 +1,36 @@
 #ifndef BPT_GA_HPP
 #define BPT_GA_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 
+#include <EASTL/unique_ptr.h>
 #include <EASTL/vector.h>
 
 #include <corex/math.hpp>
 
+#include <bpt/AdaptiveOperatorSelector.hpp>
+#include <bpt/ConstraintHandlingType.hpp>
 #include <bpt/ds.hpp>
+#include <bpt/GAParameters.hpp>
+#include <bpt/GeneEncoding.hpp>
+#include <bpt/InitializationType.hpp>
+#include <bpt/Island.hpp>
+#include <bpt/MutationSelectionType.hpp>
+#include <bpt/operators.hpp>
+#include <bpt/PerfCounters.hpp>
+#include <bpt/pareto.hpp>
+#include <bpt/ReplacementType.hpp>
+#include <bpt/RunProgressBoard.hpp>
+#include <bpt/ScrambledHaltonSequence.hpp>
 #include <bpt/SelectionType.hpp>
 
 namespace bpt
 {
   class GA
   {
+    friend class GAEngine;
   public:
     GA();
     eastl::vector<eastl::vector<Solution>> generateSolutions(
@@ -32,6 +49,54 @@ namespace bpt
       const float buildingDistanceWeight,
       const bool isLocalSearchEnabled,
       const SelectionType selectionType);
+    eastl::vector<eastl::vector<Solution>> generateSolutions(
+      const Problem& problem,
+      const GAParameters& parameters);
+    // Same as above, but with the initial population warm-started from the
+    // given seed solutions, e.g. layouts from earlier runs or drawn by hand.
+    // Seeds that are infeasible are repaired by moving their offending
+    // buildings nearby, or dropped if that fails. The rest of the initial
+    // population is made of perturbed copies of the seeds, and of random
+    // solutions. Seeds beyond the population size are ignored.
+    eastl::vector<eastl::vector<Solution>> generateSolutions(
+      const Problem& problem,
+      const GAParameters& parameters,
+      const eastl::vector<Solution>& seedSolutions);
+    // Continues evolving the final population of a run after its problem has
+    // been edited, instead of starting over. The population is remapped to
+    // the buildings of the new problem, with added buildings inserted at
+    // random feasible positions. Solutions that the edit made infeasible are
+    // repaired or dropped. Only the parts of the fitnesses affected by the
+    // edit are recomputed, unless the hazard areas, penalties or weights
+    // changed, or remapping moved buildings (e.g. by snapping rotations to
+    // the orientations of the new problem). The run then proceeds like
+    // generateSolutions() with the remapped population as seeds, for
+    // numGenerations generations.
+    eastl::vector<eastl::vector<Solution>> reoptimizeSolutions(
+      const Problem& prevProblem,
+      const Problem& problem,
+      const ProblemChange& change,
+      const eastl::vector<Solution>& prevPopulation,
+      const GAParameters& parameters);
+    // Runs the GA once per parameter set, concurrently, on numThreads threads
+    // (all hardware threads if numThreads <= 0). The problem is shared by all
+    // runs. Each run uses the fitness cache and replacement settings of this
+    // GA. Results are in the same order as the parameter sets.
+    eastl::vector<RunResult> generateSolutionsInBatch(
+      const Problem& problem,
+      const eastl::vector<GAParameters>& parameterSets,
+      const int numThreads);
+    // Computes the fitness of each solution, and whether it is feasible,
+    // concurrently, on numThreads threads (all hardware threads if
+    // numThreads <= 0). Infeasible solutions get a fitness too. The fitness
+    // cache is not used.
+    void scoreSolutions(const Problem& problem,
+                        const eastl::vector<Solution>& solutions,
+                        eastl::vector<double>& fitnesses,
+                        eastl::vector<uint8_t>& feasibilities,
+                        const int numThreads);
+    // The fitness cache is not used. To score many layouts of the same
+    // problem, scoreSolutions() is much faster.
     double getSolutionFitness(
       const Solution& solution,
       const eastl::vector<InputBuilding>& inputBuildings,
@@ -41,20 +106,268 @@ namespace bpt
       const float floodProneAreaPenalty,
       const float landslideProneAreaPenalty,
       const float buildingDistanceWeight);
+    // Multi-objective run using NSGA-II, treating the flow cost and the
+    // exposures to flood-prone and landslide-prone areas as separate
+    // objectives (see bpt/pareto.hpp). Returns the non-dominated solutions of
+    // the final population. These solutions have no fitness set. Their
+    // objectives are in getRecentRunParetoFrontObjectives(), in the same
+    // order.
+    eastl::vector<Solution> generateParetoFront(
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const cx::NPolygon& boundingArea,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas,
+      const float mutationRate,
+      const int populationSize,
+      const int numGenerations);
+    eastl::vector<Solution> generateParetoFront(
+      const Problem& problem,
+      const float mutationRate,
+      const int populationSize,
+      const int numGenerations);
+    eastl::vector<double> getSolutionObjectives(
+      const Solution& solution,
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas);
+    eastl::vector<eastl::vector<double>> getRecentRunParetoFrontObjectives();
     int getCurrentRunGenerationNumber();
+    // Latest progress of the current run, or of the most recent one if none
+    // is going on, including a copy of its best solution so far. Runs post
+    // their progress after every generation. Unlike the other getters, this
+    // one may be called from any thread while a run is going on, as often
+    // as wanted, without slowing the run down (see
+    // bpt/RunProgressBoard.hpp). Batch runs do not post their progress.
+    RunProgress getCurrentRunProgress();
     eastl::vector<float> getRecentRunAverageFitnesses();
     eastl::vector<float> getRecentRunBestFitnesses();
     eastl::vector<float> getRecentRunWorstFitnesses();
+    eastl::vector<float> getRecentRunFitnessCacheHitRates();
+    // Probabilities of the buddy-buddy, shaking and jiggle mutations being
+    // picked, and the seconds spent on each of them, per generation. Only
+    // filled in by runs with adaptive mutation selection. The first
+    // probabilities are the initial ones, and have no times.
+    eastl::vector<eastl::vector<float>> getRecentRunMutationProbabilities();
+    eastl::vector<eastl::vector<float>> getRecentRunMutationSeconds();
+    // Setting the capacity to zero disables the fitness cache.
+    void setFitnessCacheCapacity(const int capacity);
+    int getFitnessCacheCapacity();
+    // In steady-state replacement, each offspring replaces the worst solution
+    // in the population right away, if it is better than it.
+    void setReplacementType(const ReplacementType replacementType);
+    ReplacementType getReplacementType();
+    // With the compact encoding, solutions store their genes as 16-bit codes
+    // relative to the site AABB (see bpt/ds/GeneQuantizer.hpp), which halves
+    // the genes of populations and the returned history at the cost of
+    // precision. Solutions also drop their cached footprints, which take
+    // several times the memory of the genes, once they are in the
+    // population. Offsprings then compute every footprint again, which
+    // makes runs slower.
+    void setGeneEncoding(const GeneEncoding geneEncoding);
+    GeneEncoding getGeneEncoding();
+    // With adaptive mutation selection, mutations are picked based on the
+    // fitness improvement they recently made per second spent on them,
+    // rather than uniformly. The improvement is measured from the fitness
+    // the offspring had before being mutated if it is known, or else from
+    // the average fitness of its parents, so that no extra evaluation is
+    // made. Only applies to single-objective runs.
+    void setMutationSelectionType(
+      const MutationSelectionType mutationSelectionType);
+    MutationSelectionType getMutationSelectionType();
+    // Makes the following single-objective runs run as the given island of
+    // an island model. Every migration interval, the best solutions of the
+    // population are sent to the next island, and the migrants that have
+    // arrived replace the worst solutions, if they are better. The best
+    // solution is reported to the coordinator as well. The island is not
+    // owned by the GA, must already be open, and must outlive the runs.
+    // Passing nullptr turns this off.
+    void setIsland(Island* island);
+    // With penalty-based constraint handling, infeasible solutions are kept
+    // in the population instead of being resampled. Their fitness gets a
+    // penalty proportional to the area of the buildings overlapping each
+    // other and lying outside the site, with a coefficient that adapts to
+    // how often the best solution is feasible. Only feasible solutions are
+    // reported as the best ones. Until one is found, the best fitnesses
+    // are infinite. Only applies to single-objective runs.
+    void setConstraintHandlingType(
+      const ConstraintHandlingType constraintHandlingType);
+    ConstraintHandlingType getConstraintHandlingType();
+    // With scrambled Halton initialization, the random solutions of initial
+    // populations take the position and rotation of each building from a
+    // low-discrepancy sequence over (x, y, rotation), with one sequence per
+    // building (see bpt/ScrambledHaltonSequence.hpp). The buildings then
+    // cover the site more evenly across the population than with uniform
+    // sampling. Points that make a building stick out of the site, or a
+    // solution not be allowed, are skipped like uniform samples are.
+    void setInitializationType(const InitializationType initializationType);
+    InitializationType getInitializationType();
+    // With sampling on, the cycles, instructions, last-level cache misses
+    // and branch misses of each GA phase are counted with hardware
+    // performance counters (see bpt/PerfCounters.hpp) during the following
+    // single-objective runs. This slows runs down a little, since counters
+    // are read whenever a phase starts or ends. Phases nested in another
+    // one are counted as part of it.
+    void setPerfCounterSampling(const bool isEnabled);
+    bool isPerfCounterSamplingEnabled();
+    // Counts per generation, starting with the initial population, and per
+    // phase, in the order of GAPhase. Empty if sampling was off, or if no
+    // counters were available.
+    eastl::vector<eastl::vector<PerfCounts>> getRecentRunPerfCounts();
   private:
-    eastl::array<Solution, 2> selectParents(
+    static constexpr int numMutations = 3;
+
+    struct PopulationEntry
+    {
+      double fitness;
+      int solutionIndex;
+
+      bool operator<(const PopulationEntry& other) const
+      {
+        return this->fitness < other.fitness;
+      }
+    };
+
+    // State of a single-objective run in between generations.
+    struct RunState
+    {
+      GAParameters parameters;
+      eastl::vector<Solution> population;
+      // The population of every generation so far, if kept.
+      eastl::vector<eastl::vector<Solution>> history;
+      bool shouldKeepHistory = false;
+      // In steady-state replacement, we keep track of the best and worst
+      // solutions, and the fitness sum incrementally instead.
+      MinMaxHeap<PopulationEntry> populationHeap;
+      double fitnessSum = 0.0;
+      double fitnessAverage = 0.0;
+      Solution bestSolution;
+      Solution worstSolution;
+      // With penalties, only feasible solutions may be reported as the best.
+      Solution bestFeasibleSolution;
+      bool hasBestFeasibleSolution = false;
+      bool isPenalized = false;
+      // Set when the penalty coefficient changed at the end of a generation.
+      // The population is rescored when the next generation starts, so that
+      // it stays as it was recorded until then.
+      bool isPopulationStale = false;
+      int numGenerationsDone = 0;
+    };
+
+    double computeSolutionFitness(const Solution& solution,
+                                  const Problem& problem);
+    double computeUncachedSolutionFitness(const Solution& solution,
+                                          const Problem& problem);
+    // Total area of the buildings overlapping each other, and lying outside
+    // the site.
+    double computeConstraintViolation(const Solution& solution,
+                                      const Problem& problem);
+    double computeInitialPenaltyCoefficient(
+      const eastl::vector<Solution>& population,
+      const Problem& problem);
+    // Returns whether the coefficient has changed.
+    bool updatePenaltyCoefficient(const bool isBestSolutionFeasible);
+    void updateBestFeasibleSolution(
       const eastl::vector<Solution>& population,
-      const int& tournamentSize,
-      const SelectionType& selectionType);
-    eastl::array<Solution, 2> runRouletteWheelSelection(
+      const Problem& problem,
+      Solution& bestFeasibleSolution,
+      bool& hasBestFeasibleSolution);
+    void rescorePopulation(
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum,
+      const Problem& problem);
+    ObjectiveVector computeSolutionObjectives(const Solution& solution,
+                                              const Problem& problem);
+    // Same as above, but straight from the problem data, so that single
+    // layouts can be scored without the cost of preparing a Problem. Many
+    // layouts are better scored with a Problem and scoreSolutions().
+    ObjectiveVector computeSolutionObjectives(
+      const Solution& solution,
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const eastl::vector<eastl::vector<float>>& flowRates,
+      const eastl::vector<cx::NPolygon>& floodProneAreas,
+      const eastl::vector<cx::NPolygon>& landslideProneAreas);
+    void selectParetoSurvivors(
+      eastl::vector<Solution>& pool,
+      eastl::vector<ObjectiveVector>& poolObjectives,
+      eastl::vector<int>& ranks,
+      eastl::vector<double>& crowdingDistances,
+      const int populationSize);
+    void recordFitnessCacheHitRate();
+    void recordPerfCounts();
+    // Whole single-objective run, returning the population of every
+    // generation. Scored seeds are taken as they are. They must already
+    // have the gene encoding of this GA, be feasible, and have their
+    // fitness set.
+    eastl::vector<eastl::vector<Solution>> runGA(
+      const Problem& problem,
+      const GAParameters& parameters,
+      const eastl::vector<Solution>& seedSolutions,
+      const bool areSeedsScored);
+    // A run is split into its initial population, any number of calls
+    // running generations on it, and its end, so that GAEngine can run it
+    // bit by bit.
+    void beginRun(RunState& state,
+                  const Problem& problem,
+                  const GAParameters& parameters,
+                  const eastl::vector<Solution>& seedSolutions,
+                  const bool areSeedsScored);
+    // Runs the generations with one of the instantiations below, based on
+    // the selection type of the run and the mutation selection type.
+    void dispatchGenerations(RunState& state,
+                             const Problem& problem,
+                             const int numGenerations);
+    // The GA proper, with its operators fixed at compile time (see
+    // bpt/operators.hpp).
+    template <typename SelectionPolicy,
+              typename CrossoverPolicy,
+              typename MutationPolicy>
+    void runGenerations(RunState& state,
+                        const Problem& problem,
+                        const int numGenerations);
+    void endRun(RunState& state);
+    // Records the statistics of the latest generation, and posts the
+    // progress of the run.
+    void recordGenerationStatistics(const RunState& state);
+    // nullptr if the run has no solution that may be reported as the best.
+    const Solution* getReportedBestSolution(const RunState& state) const;
+    // Infinite if the run has no best solution.
+    float getReportedBestFitness(const RunState& state) const;
+    void generateInitialPopulation(
+      eastl::vector<Solution>& population,
+      const eastl::vector<Solution>& seedSolutions,
+      const bool areSeedsScored,
+      const Problem& problem);
+    // Tries to make the solution feasible by moving its offending buildings
+    // around their current positions. Returns whether it succeeded.
+    bool repairSolution(Solution& solution, const Problem& problem);
+    // Places a building at a random position where it is within the site and
+    // does not overlap the buildings before it. Returns whether it found
+    // one.
+    bool insertBuilding(Solution& solution,
+                        const int buildingIndex,
+                        const Problem& problem);
+    // Fitness term of the flow from one building to another.
+    double computeFlowFitness(const Solution& solution,
+                              const Problem& problem,
+                              const int fromBuilding,
+                              const int toBuilding,
+                              const float flowRate);
+    // Fitness term of the hazard areas a building is in.
+    double computeHazardFitness(const Solution& solution,
+                                const Problem& problem,
+                                const int buildingIndex);
+    // Both return the indices of the parents in the population.
+    eastl::array<int, 2> selectParents(
+      RouletteWheelSelection,
       const eastl::vector<Solution>& population);
-    eastl::array<Solution, 2> runTournamentSelection(
+    eastl::array<int, 2> selectParents(
+      TournamentSelection,
       const eastl::vector<Solution>& population,
-      const int& tournamentSize);
+      const int tournamentSize);
+    template <typename CrossoverPolicy, typename MutationPolicy>
     void makeTwoParentsBreed(
       const Solution& parentA,
       const Solution& parentB,
@@ -62,51 +375,124 @@ namespace bpt
       int& numOffsprings,
       const int numOffspringsToMake,
       const float mutationRate,
-      const cx::NPolygon& boundingArea,
-      const eastl::vector<InputBuilding>& inputBuildings,
-      const eastl::vector<eastl::vector<float>>& flowRates,
-      const eastl::vector<cx::NPolygon>& floodProneAreas,
-      const eastl::vector<cx::NPolygon>& landslideProneAreas,
-      const float floodProneAreaPenalty,
-      const float landslideProneAreaPenalty,
-      const float buildingDistanceWeight);
+      const Problem& problem);
+    // The baseline fitness is what adaptive mutation measures improvements
+    // from.
+    template <typename MutationPolicy>
+    void finalizeOffspring(
+      Solution& offspring,
+      const double baselineFitness,
+      const float mutationRate,
+      const Problem& problem);
+    template <typename MutationPolicy>
+    void mutateOffspring(MutationPolicy,
+                         Solution& offspring,
+                         const double baselineFitness,
+                         const Problem& problem);
+    void mutateOffspring(AdaptiveMutation,
+                         Solution& offspring,
+                         const double baselineFitness,
+                         const Problem& problem);
+    void exchangeMigrants(
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum,
+      const Problem& problem);
+    void replaceWorstSolution(
+      Solution& offspring,
+      eastl::vector<Solution>& population,
+      MinMaxHeap<PopulationEntry>& populationHeap,
+      double& fitnessSum);
+    Solution createEmptySolution(const Problem& problem);
+    // Copies the genes of a solution coming from outside of the GA into one
+    // with the gene encoding of this GA.
+    Solution importSolution(const Solution& solution, const Problem& problem);
+    // Starts new initialization sequences for the next random solutions,
+    // if initialization uses them.
+    void resetInitializationSequences(const Problem& problem);
     Solution
-    generateRandomSolution(const eastl::vector<InputBuilding>& inputBuildings,
-                           const cx::NPolygon& boundingArea);
+    generateRandomSolution(const Problem& problem);
+    float generateRandomRotation(const Problem& problem);
     eastl::array<Solution, 2>
-    crossoverSolutions(const Solution& solutionA,
+    crossoverSolutions(UniformCrossover,
+                       const Solution& solutionA,
                        const Solution& solutionB,
-                       const cx::NPolygon& boundingArea,
-                       const eastl::vector<InputBuilding>& inputBuildings);
-    void mutateSolution(Solution& solution,
-                        const cx::NPolygon& boundingArea,
-                        const eastl::vector<InputBuilding>& inputBuildings);
-    void applyBuddyBuddyMutation(
-        Solution& solution,
-        const cx::NPolygon& boundingArea,
-        const eastl::vector<InputBuilding>& inputBuildings);
-    void applyShakingMutation(
-        Solution& solution,
-        const cx::NPolygon& boundingArea,
-        const eastl::vector<InputBuilding>& inputBuildings);
-    void applyJiggleMutation(
-        Solution& solution,
-        const cx::NPolygon& boundingArea,
-        const eastl::vector<InputBuilding>& inputBuildings);
+                       const Problem& problem);
+    void mutateSolution(RandomMutation,
+                        Solution& solution,
+                        const Problem& problem);
+    // Applies the mutation with the given index, in the order of the
+    // mutation policies below.
+    void applyMutation(const int mutationIndex,
+                       Solution& solution,
+                       const Problem& problem);
+    void mutateSolution(BuddyBuddyMutation,
+                        Solution& solution,
+                        const Problem& problem);
+    void mutateSolution(ShakingMutation,
+                        Solution& solution,
+                        const Problem& problem);
+    void mutateSolution(JiggleMutation,
+                        Solution& solution,
+                        const Problem& problem);
+    bool isSolutionFeasible(const Solution& solution,
+                            const Problem& problem);
+    // Same as above, for a solution that was feasible before the given
+    // buildings were modified. Only pairs involving a modified building can
+    // have changed, so just the modified buildings are checked against the
+    // site and the other buildings, in O(n * k) rather than O(n^2) for k
+    // modified buildings.
     bool isSolutionFeasible(const Solution& solution,
-                            const cx::NPolygon& boundingArea,
-                            const eastl::vector<InputBuilding>& inputBuildings);
+                            const eastl::vector<int>& modifiedBuildings,
+                            const Problem& problem);
+    // Whether an operator may produce the solution. Always true in runs
+    // with penalty-based constraint handling.
+    bool isSolutionAllowed(const Solution& solution,
+                           const Problem& problem);
+    bool isSolutionAllowed(const Solution& solution,
+                           const eastl::vector<int>& modifiedBuildings,
+                           const Problem& problem);
     bool doesSolutionHaveNoBuildingsOverlapping(
         const Solution& solution,
-        const eastl::vector<InputBuilding>& inputBuildings);
+        const Problem& problem);
     bool areSolutionBuildingsWithinBounds(
         const Solution& solution,
-        const cx::NPolygon& boundingArea,
-        const eastl::vector<InputBuilding>& inputBuildings);
-    int currRunGenerationNumber;
+        const Problem& problem);
+    void addPopulationToHistory(
+        eastl::vector<eastl::vector<Solution>>& history,
+        const eastl::vector<Solution>& population);
+    // Only done with the compact encoding, which trades speed for memory.
+    void releaseFootprintCaches(eastl::vector<Solution>& population);
+    std::atomic<int> currRunGenerationNumber;
     eastl::vector<float> recentRunAvgFitnesses;
     eastl::vector<float> recentRunBestFitnesses;
     eastl::vector<float> recentRunWorstFitnesses;
+    eastl::vector<float> recentRunFitnessCacheHitRates;
+    eastl::vector<eastl::vector<float>> recentRunMutationProbabilities;
+    eastl::vector<eastl::vector<float>> recentRunMutationSeconds;
+    eastl::unique_ptr<FitnessCache> fitnessCache;
+    ReplacementType replacementType;
+    GeneEncoding geneEncoding;
+    MutationSelectionType mutationSelectionType;
+    AdaptiveOperatorSelector mutationSelector;
+    Island* island;
+    ConstraintHandlingType constraintHandlingType;
+    bool isCurrRunPenalized;
+    double penaltyCoefficient;
+    double minPenaltyCoefficient;
+    double maxPenaltyCoefficient;
+    int numFeasibleBestGenerations;
+    int numInfeasibleBestGenerations;
+    InitializationType initializationType;
+    eastl::vector<ScrambledHaltonSequence> initializationSequences;
+    bool shouldSamplePerfCounters;
+    // Only set while a run is sampling counters.
+    eastl::unique_ptr<PerfCounters> perfCounters;
+    eastl::vector<eastl::vector<PerfCounts>> recentRunPerfCounts;
+    eastl::vector<eastl::vector<double>> recentRunParetoFrontObjectives;
+    uint64_t numCurrRunEvaluations;
+    uint64_t numCurrRunCachedEvaluations;
+    RunProgressBoard progressBoard;
   };
 }
 
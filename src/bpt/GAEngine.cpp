@@ -0,0 +1,107 @@
+#include <cassert>
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Problem.hpp>
+#include <bpt/ds/Solution.hpp>
+#include <bpt/GA.hpp>
+#include <bpt/GAEngine.hpp>
+#include <bpt/GAParameters.hpp>
+
+namespace bpt
+{
+  GAEngine::GAEngine(const Problem& problem, const GAParameters& parameters)
+      : problem(problem)
+      , ga()
+      , runState()
+      , isRunInitialized(false)
+      , isRunFinished(false)
+  {
+    this->runState.parameters = parameters;
+  }
+
+  GA& GAEngine::getGA()
+  {
+    return this->ga;
+  }
+
+  void GAEngine::initialize()
+  {
+    this->initialize(eastl::vector<Solution>{});
+  }
+
+  void GAEngine::initialize(const eastl::vector<Solution>& seedSolutions)
+  {
+    const GAParameters parameters = this->runState.parameters;
+    this->ga.beginRun(this->runState,
+                      this->problem,
+                      parameters,
+                      seedSolutions,
+                      false);
+    this->isRunInitialized = true;
+    this->isRunFinished = false;
+  }
+
+  void GAEngine::step(const int numGenerations)
+  {
+    assert(this->isRunInitialized && !this->isRunFinished);
+    assert(numGenerations >= 0);
+    this->ga.dispatchGenerations(this->runState,
+                                 this->problem,
+                                 numGenerations);
+  }
+
+  void GAEngine::finish()
+  {
+    assert(this->isRunInitialized && !this->isRunFinished);
+    this->ga.endRun(this->runState);
+    this->isRunFinished = true;
+  }
+
+  bool GAEngine::isInitialized() const
+  {
+    return this->isRunInitialized;
+  }
+
+  bool GAEngine::isFinished() const
+  {
+    return this->isRunFinished;
+  }
+
+  int GAEngine::getNumGenerationsDone() const
+  {
+    return this->runState.numGenerationsDone;
+  }
+
+  void GAEngine::setMutationRate(const float mutationRate)
+  {
+    this->runState.parameters.mutationRate = mutationRate;
+  }
+
+  float GAEngine::getMutationRate() const
+  {
+    return this->runState.parameters.mutationRate;
+  }
+
+  const GAParameters& GAEngine::getParameters() const
+  {
+    return this->runState.parameters;
+  }
+
+  const eastl::vector<Solution>& GAEngine::getPopulation() const
+  {
+    return this->runState.population;
+  }
+
+  bool GAEngine::hasBestSolution() const
+  {
+    return this->isRunInitialized
+           && this->ga.getReportedBestSolution(this->runState) != nullptr;
+  }
+
+  const Solution& GAEngine::getBestSolution() const
+  {
+    assert(this->hasBestSolution());
+    return *this->ga.getReportedBestSolution(this->runState);
+  }
+}
@@ -0,0 +1,68 @@
+#ifndef BPT_GA_ENGINE_HPP
+#define BPT_GA_ENGINE_HPP
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Problem.hpp>
+#include <bpt/ds/Solution.hpp>
+#include <bpt/GA.hpp>
+#include <bpt/GAParameters.hpp>
+
+namespace bpt
+{
+  // Single-objective GA run driven a few generations at a time by the
+  // caller, instead of from start to end in one call like
+  // GA::generateSolutions(). The engine owns the state of the run in
+  // between steps, so that GA work can be interleaved with other tasks,
+  // e.g. in an event loop, the mutation rate can be changed in between
+  // steps, and many runs can be time-sliced on one thread with one engine
+  // per run.
+  //
+  // The run uses the settings of the GA of the engine, which are to be set
+  // before initializing it. The statistics and progress of the run are
+  // available from that GA too, e.g. getRecentRunBestFitnesses(). The GA
+  // must not be used for other runs while the engine is. Unlike
+  // generateSolutions(), the engine does not keep the population of every
+  // generation, so it can run for as long as wanted.
+  class GAEngine
+  {
+  public:
+    // The problem must outlive the engine. The number of generations in
+    // the parameters is not used, since steps decide how many are run.
+    GAEngine(const Problem& problem, const GAParameters& parameters);
+
+    GA& getGA();
+    // Generates the initial population, starting the run over if there
+    // already is one.
+    void initialize();
+    // Same as above, but warm-started from the given seed solutions, like
+    // GA::generateSolutions().
+    void initialize(const eastl::vector<Solution>& seedSolutions);
+    // Runs numGenerations more generations. The engine must be initialized.
+    void step(const int numGenerations);
+    // Ends the run, reporting its best solution to the island of the GA as
+    // the final one, if there is an island. The population stays available
+    // until the engine is initialized again.
+    void finish();
+    bool isInitialized() const;
+    bool isFinished() const;
+    int getNumGenerationsDone() const;
+    // Takes effect from the next step on.
+    void setMutationRate(const float mutationRate);
+    float getMutationRate() const;
+    const GAParameters& getParameters() const;
+    const eastl::vector<Solution>& getPopulation() const;
+    // With penalty-based constraint handling, only feasible solutions may
+    // be the best, so there is no best solution until one is found.
+    bool hasBestSolution() const;
+    const Solution& getBestSolution() const;
+  private:
+    const Problem& problem;
+    GA ga;
+    GA::RunState runState;
+    bool isRunInitialized;
+    bool isRunFinished;
+  };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef BPT_GA_PARAMETERS_HPP
+#define BPT_GA_PARAMETERS_HPP
+
+#include <bpt/SelectionType.hpp>
+
+namespace bpt
+{
+  struct GAParameters
+  {
+    float mutationRate;
+    int populationSize;
+    int numGenerations;
+    int tournamentSize;
+    int numPrevGenOffsprings;
+    bool isLocalSearchEnabled;
+    SelectionType selectionType;
+  };
+
+  // Whether a run can be made with the parameters. The population and
+  // tournament sizes must be positive, the tournament no larger than the
+  // population, the number of generations non-negative, and the number of
+  // offsprings kept from the previous generation within the population.
+  inline bool areGAParametersValid(const GAParameters& parameters)
+  {
+    return parameters.populationSize > 0
+           && parameters.numGenerations >= 0
+           && parameters.tournamentSize > 0
+           && parameters.tournamentSize <= parameters.populationSize
+           && parameters.numPrevGenOffsprings >= 0
+           && parameters.numPrevGenOffsprings <= parameters.populationSize;
+  }
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef BPT_GA_PHASE
+#define BPT_GA_PHASE
+
+namespace bpt
+{
+  // Phases of a GA run that hardware performance counters are read around.
+  // NUM_GA_PHASES is not a phase, but the number of phases.
+  enum class GAPhase
+  {
+    INITIAL_POPULATION,
+    SELECTION,
+    CROSSOVER,
+    MUTATION,
+    FITNESS,
+    FEASIBILITY,
+    REPLACEMENT,
+    NUM_GA_PHASES
+  };
+}
+
+#endif
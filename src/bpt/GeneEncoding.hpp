@@ -0,0 +1,9 @@
+#ifndef BPT_GENE_ENCODING
+#define BPT_GENE_ENCODING
+
+namespace bpt
+{
+  enum class GeneEncoding { FULL, COMPACT };
+}
+
+#endif
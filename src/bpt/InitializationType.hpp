@@ -0,0 +1,9 @@
+#ifndef BPT_INITIALIZATION_TYPE
+#define BPT_INITIALIZATION_TYPE
+
+namespace bpt
+{
+  enum class InitializationType { UNIFORM, SCRAMBLED_HALTON };
+}
+
+#endif
@@ -0,0 +1,811 @@
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <EASTL/string.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Solution.hpp>
+#include <bpt/Island.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    // Every message starts with a header of three 32-bit values:
+    //   [ message type, index of the sending island, payload size ]
+    // A migrants payload is a 32-bit solution count followed by the
+    // solutions. A best or final solution payload is a single solution.
+    // A solution is a 32-bit building count, the fitness as a double, and
+    // then the genes as floats.
+    enum class MessageType : uint32_t
+    {
+      MIGRANTS = 1,
+      BEST_SOLUTION = 2,
+      FINAL_SOLUTION = 3
+    };
+
+    constexpr size_t messageHeaderSize = sizeof(uint32_t) * 3;
+    constexpr uint32_t maxPayloadSize = 64u << 20;
+
+    // Messages for an island we are not connected to pile up until we
+    // connect. Past this size, they are all dropped.
+    constexpr size_t maxPendingSize = 4u << 20;
+
+    constexpr auto reconnectionDelay = std::chrono::milliseconds(100);
+    constexpr auto closingFlushTimeout = std::chrono::seconds(2);
+    constexpr int pollTimeoutMs = 100;
+
+    template <typename T>
+    void appendValue(eastl::vector<uint8_t>& buffer, const T value)
+    {
+      const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(const uint8_t*& cursor, const uint8_t* end, T& value)
+    {
+      if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+        return false;
+      }
+
+      std::memcpy(&value, cursor, sizeof(T));
+      cursor += sizeof(T);
+      return true;
+    }
+
+    void appendSolution(eastl::vector<uint8_t>& buffer,
+                        const Solution& solution)
+    {
+      appendValue<int32_t>(buffer, solution.getNumBuildings());
+      appendValue<double>(buffer, solution.getFitness());
+      for (int i = 0; i < solution.getNumBuildings(); i++) {
+        appendValue<float>(buffer, solution.getBuildingXPos(i));
+        appendValue<float>(buffer, solution.getBuildingYPos(i));
+        appendValue<float>(buffer, solution.getBuildingRotation(i));
+      }
+    }
+
+    bool readSolution(const uint8_t*& cursor,
+                      const uint8_t* end,
+                      Solution& solution)
+    {
+      int32_t numBuildings = 0;
+      double fitness = 0.0;
+      if (!readValue(cursor, end, numBuildings)
+          || !readValue(cursor, end, fitness)
+          || numBuildings < 0
+          || static_cast<size_t>(end - cursor)
+             < static_cast<size_t>(numBuildings) * sizeof(float) * 3) {
+        return false;
+      }
+
+      solution = Solution{ numBuildings };
+      for (int i = 0; i < numBuildings; i++) {
+        float xPos = 0.f;
+        float yPos = 0.f;
+        float rotation = 0.f;
+        readValue(cursor, end, xPos);
+        readValue(cursor, end, yPos);
+        readValue(cursor, end, rotation);
+        solution.setBuildingXPos(i, xPos);
+        solution.setBuildingYPos(i, yPos);
+        solution.setBuildingRotation(i, rotation);
+      }
+
+      solution.setFitness(fitness);
+      return true;
+    }
+
+    eastl::vector<uint8_t> makeMessage(const MessageType type,
+                                       const int islandIndex,
+                                       const eastl::vector<uint8_t>& payload)
+    {
+      eastl::vector<uint8_t> message;
+      message.reserve(messageHeaderSize + payload.size());
+      appendValue<uint32_t>(message, static_cast<uint32_t>(type));
+      appendValue<uint32_t>(message, static_cast<uint32_t>(islandIndex));
+      appendValue<uint32_t>(message, static_cast<uint32_t>(payload.size()));
+      message.insert(message.end(), payload.begin(), payload.end());
+      return message;
+    }
+
+    bool isUnixAddress(const eastl::string& address)
+    {
+      return address.compare(0, 5, "unix:") == 0;
+    }
+
+    eastl::string getUnixAddressPath(const eastl::string& address)
+    {
+      return address.substr(5);
+    }
+
+    bool parseAddress(const eastl::string& address,
+                      sockaddr_storage& socketAddress,
+                      socklen_t& socketAddressLength)
+    {
+      std::memset(&socketAddress, 0, sizeof(socketAddress));
+
+      if (isUnixAddress(address)) {
+        const eastl::string path = getUnixAddressPath(address);
+        sockaddr_un unixAddress;
+        std::memset(&unixAddress, 0, sizeof(unixAddress));
+        if (path.empty() || path.size() >= sizeof(unixAddress.sun_path)) {
+          return false;
+        }
+
+        unixAddress.sun_family = AF_UNIX;
+        std::memcpy(unixAddress.sun_path, path.c_str(), path.size());
+        std::memcpy(&socketAddress, &unixAddress, sizeof(unixAddress));
+        socketAddressLength = sizeof(unixAddress);
+        return true;
+      }
+
+      const size_t separatorIndex = address.find_last_of(':');
+      if (separatorIndex == eastl::string::npos
+          || separatorIndex == 0
+          || separatorIndex + 1 == address.size()) {
+        return false;
+      }
+
+      const eastl::string host = address.substr(0, separatorIndex);
+      const eastl::string port = address.substr(separatorIndex + 1);
+
+      addrinfo hints;
+      std::memset(&hints, 0, sizeof(hints));
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+
+      addrinfo* results = nullptr;
+      if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0
+          || results == nullptr) {
+        return false;
+      }
+
+      std::memcpy(&socketAddress, results->ai_addr, results->ai_addrlen);
+      socketAddressLength = results->ai_addrlen;
+      freeaddrinfo(results);
+      return true;
+    }
+
+    bool makeNonBlocking(const int fd)
+    {
+      const int flags = fcntl(fd, F_GETFL, 0);
+      return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    void moveBytes(eastl::vector<uint8_t>& source,
+                   eastl::vector<uint8_t>& destination)
+    {
+      destination.insert(destination.end(), source.begin(), source.end());
+      source.clear();
+    }
+  }
+
+  Island::Island(const int islandIndex,
+                 const eastl::vector<eastl::string>& addresses,
+                 const int numMigrants,
+                 const int migrationInterval)
+      : islandIndex(islandIndex)
+      , addresses(addresses)
+      , numMigrants(numMigrants)
+      , migrationInterval(std::max(1, migrationInterval))
+      , listeningSocket(-1)
+      , wakeUpPipe{ -1, -1 }
+      , ioThread()
+      , isStopping(false)
+      , mutex()
+      , finalSolutionsCondition()
+      , pendingNextIslandBytes()
+      , pendingCoordinatorBytes()
+      , receivedMigrants()
+      , bestSolutions(addresses.size())
+      , hasBestSolution(addresses.size(), false)
+      , hasFinalSolution(addresses.size(), false)
+      , nextIslandConnection{ -1, false, {}, {} }
+      , coordinatorConnection{ -1, false, {}, {} }
+      , incomingConnections() {}
+
+  Island::~Island()
+  {
+    this->close();
+  }
+
+  bool Island::open()
+  {
+    if (this->ioThread.joinable()
+        || this->islandIndex < 0
+        || this->islandIndex >= this->getNumIslands()) {
+      return false;
+    }
+
+    const eastl::string& address = this->addresses[this->islandIndex];
+    sockaddr_storage socketAddress;
+    socklen_t socketAddressLength = 0;
+    if (!parseAddress(address, socketAddress, socketAddressLength)) {
+      return false;
+    }
+
+    this->listeningSocket = socket(socketAddress.ss_family, SOCK_STREAM, 0);
+    if (this->listeningSocket < 0) {
+      return false;
+    }
+
+    if (isUnixAddress(address)) {
+      // Remove the socket file left behind by a previous run, if any.
+      unlink(getUnixAddressPath(address).c_str());
+    } else {
+      const int isReusingAddress = 1;
+      setsockopt(this->listeningSocket,
+                 SOL_SOCKET,
+                 SO_REUSEADDR,
+                 &isReusingAddress,
+                 sizeof(isReusingAddress));
+    }
+
+    if (bind(this->listeningSocket,
+             reinterpret_cast<const sockaddr*>(&socketAddress),
+             socketAddressLength) != 0
+        || listen(this->listeningSocket, SOMAXCONN) != 0
+        || !makeNonBlocking(this->listeningSocket)
+        || pipe(this->wakeUpPipe) != 0) {
+      this->close();
+      return false;
+    }
+
+    makeNonBlocking(this->wakeUpPipe[0]);
+    makeNonBlocking(this->wakeUpPipe[1]);
+
+    this->isStopping = false;
+    this->ioThread = std::thread{ &Island::runIOLoop, this };
+    return true;
+  }
+
+  void Island::close()
+  {
+    if (this->ioThread.joinable()) {
+      this->isStopping = true;
+      this->wakeUpIOLoop();
+      this->ioThread.join();
+    }
+
+    auto closeFD = [](int& fd) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    };
+    closeFD(this->listeningSocket);
+    closeFD(this->wakeUpPipe[0]);
+    closeFD(this->wakeUpPipe[1]);
+
+    if (this->islandIndex >= 0
+        && this->islandIndex < this->getNumIslands()
+        && isUnixAddress(this->addresses[this->islandIndex])) {
+      unlink(getUnixAddressPath(this->addresses[this->islandIndex]).c_str());
+    }
+  }
+
+  int Island::getIslandIndex() const
+  {
+    return this->islandIndex;
+  }
+
+  int Island::getNumIslands() const
+  {
+    return static_cast<int>(this->addresses.size());
+  }
+
+  int Island::getNumMigrants() const
+  {
+    return this->numMigrants;
+  }
+
+  int Island::getMigrationInterval() const
+  {
+    return this->migrationInterval;
+  }
+
+  bool Island::isCoordinator() const
+  {
+    return this->islandIndex == 0;
+  }
+
+  void Island::sendMigrants(const eastl::vector<Solution>& migrants)
+  {
+    if (this->getNumIslands() < 2 || migrants.empty()) {
+      return;
+    }
+
+    eastl::vector<uint8_t> payload;
+    appendValue<uint32_t>(payload, static_cast<uint32_t>(migrants.size()));
+    for (const Solution& migrant : migrants) {
+      appendSolution(payload, migrant);
+    }
+
+    this->queueMessage(this->pendingNextIslandBytes,
+                       makeMessage(MessageType::MIGRANTS,
+                                   this->islandIndex,
+                                   payload));
+  }
+
+  eastl::vector<Solution> Island::receiveMigrants()
+  {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    eastl::vector<Solution> migrants;
+    migrants.swap(this->receivedMigrants);
+    return migrants;
+  }
+
+  void Island::reportBestSolution(const Solution& solution)
+  {
+    if (this->isCoordinator()) {
+      this->recordSolution(this->islandIndex, solution, false);
+      return;
+    }
+
+    eastl::vector<uint8_t> payload;
+    appendSolution(payload, solution);
+    this->queueMessage(this->pendingCoordinatorBytes,
+                       makeMessage(MessageType::BEST_SOLUTION,
+                                   this->islandIndex,
+                                   payload));
+  }
+
+  void Island::reportFinalSolution(const Solution& solution)
+  {
+    if (this->isCoordinator()) {
+      this->recordSolution(this->islandIndex, solution, true);
+      return;
+    }
+
+    eastl::vector<uint8_t> payload;
+    appendSolution(payload, solution);
+    this->queueMessage(this->pendingCoordinatorBytes,
+                       makeMessage(MessageType::FINAL_SOLUTION,
+                                   this->islandIndex,
+                                   payload));
+  }
+
+  bool Island::hasGlobalBestSolution()
+  {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    return std::find(this->hasBestSolution.begin(),
+                     this->hasBestSolution.end(),
+                     true) != this->hasBestSolution.end();
+  }
+
+  Solution Island::getGlobalBestSolution()
+  {
+    std::lock_guard<std::mutex> lock{ this->mutex };
+    int bestIndex = -1;
+    for (int i = 0; i < this->bestSolutions.size(); i++) {
+      if (this->hasBestSolution[i]
+          && (bestIndex < 0
+              || this->bestSolutions[i].getFitness()
+                 < this->bestSolutions[bestIndex].getFitness())) {
+        bestIndex = i;
+      }
+    }
+
+    assert(bestIndex >= 0);
+    return this->bestSolutions[bestIndex];
+  }
+
+  bool Island::waitForFinalSolutions(const int timeoutMs)
+  {
+    std::unique_lock<std::mutex> lock{ this->mutex };
+    auto haveAllIslandsFinished = [this]() {
+      return std::find(this->hasFinalSolution.begin(),
+                       this->hasFinalSolution.end(),
+                       false) == this->hasFinalSolution.end();
+    };
+
+    if (timeoutMs < 0) {
+      this->finalSolutionsCondition.wait(lock, haveAllIslandsFinished);
+      return true;
+    }
+
+    return this->finalSolutionsCondition.wait_for(
+        lock,
+        std::chrono::milliseconds(timeoutMs),
+        haveAllIslandsFinished);
+  }
+
+  void Island::queueMessage(eastl::vector<uint8_t>& pendingBytes,
+                            const eastl::vector<uint8_t>& message)
+  {
+    {
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      pendingBytes.insert(pendingBytes.end(), message.begin(), message.end());
+    }
+
+    this->wakeUpIOLoop();
+  }
+
+  void Island::recordSolution(const int islandIndex,
+                              const Solution& solution,
+                              const bool isFinal)
+  {
+    if (islandIndex < 0 || islandIndex >= this->getNumIslands()) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock{ this->mutex };
+      if (!this->hasBestSolution[islandIndex]
+          || solution.getFitness()
+             < this->bestSolutions[islandIndex].getFitness()) {
+        this->bestSolutions[islandIndex] = solution;
+        this->hasBestSolution[islandIndex] = true;
+      }
+
+      if (isFinal) {
+        this->hasFinalSolution[islandIndex] = true;
+      }
+    }
+
+    if (isFinal) {
+      this->finalSolutionsCondition.notify_all();
+    }
+  }
+
+  void Island::runIOLoop()
+  {
+    using Clock = std::chrono::steady_clock;
+
+    const int nextIslandIndex = (this->islandIndex + 1)
+                                % this->getNumIslands();
+    bool hasStopDeadline = false;
+    Clock::time_point stopDeadline;
+    Clock::time_point nextConnectionTime = Clock::now();
+
+    eastl::vector<pollfd> pollFDs;
+    eastl::vector<Connection*> polledConnections;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock{ this->mutex };
+        moveBytes(this->pendingNextIslandBytes,
+                  this->nextIslandConnection.outBuffer);
+        moveBytes(this->pendingCoordinatorBytes,
+                  this->coordinatorConnection.outBuffer);
+      }
+
+      // Nothing has been sent yet to an island we are not connected to, so
+      // its messages can be dropped whole.
+      for (Connection* connection : { &this->nextIslandConnection,
+                                      &this->coordinatorConnection }) {
+        if (connection->socket < 0
+            && connection->outBuffer.size() > maxPendingSize) {
+          connection->outBuffer.clear();
+        }
+      }
+
+      const Clock::time_point now = Clock::now();
+      if (this->isStopping) {
+        if (!hasStopDeadline) {
+          hasStopDeadline = true;
+          stopDeadline = now + closingFlushTimeout;
+        }
+
+        if (now >= stopDeadline
+            || (this->nextIslandConnection.outBuffer.empty()
+                && this->coordinatorConnection.outBuffer.empty())) {
+          break;
+        }
+      }
+
+      // Connect lazily, since the other islands may not be up yet.
+      if (now >= nextConnectionTime) {
+        if (this->nextIslandConnection.socket < 0
+            && !this->nextIslandConnection.outBuffer.empty()) {
+          this->connectToIsland(this->nextIslandConnection, nextIslandIndex);
+        }
+
+        if (this->coordinatorConnection.socket < 0
+            && !this->coordinatorConnection.outBuffer.empty()) {
+          this->connectToIsland(this->coordinatorConnection, 0);
+        }
+
+        nextConnectionTime = now + reconnectionDelay;
+      }
+
+      pollFDs.clear();
+      polledConnections.clear();
+      pollFDs.push_back(pollfd{ this->wakeUpPipe[0], POLLIN, 0 });
+      pollFDs.push_back(pollfd{ this->listeningSocket, POLLIN, 0 });
+      for (Connection* connection : { &this->nextIslandConnection,
+                                      &this->coordinatorConnection }) {
+        if (connection->socket >= 0) {
+          const bool isWriting = connection->isConnecting
+                                 || !connection->outBuffer.empty();
+          pollFDs.push_back(pollfd{
+              connection->socket,
+              static_cast<short>(POLLIN | (isWriting ? POLLOUT : 0)),
+              0
+          });
+          polledConnections.push_back(connection);
+        }
+      }
+
+      for (Connection& connection : this->incomingConnections) {
+        pollFDs.push_back(pollfd{ connection.socket, POLLIN, 0 });
+        polledConnections.push_back(&connection);
+      }
+
+      if (poll(pollFDs.data(), pollFDs.size(), pollTimeoutMs) <= 0) {
+        continue;
+      }
+
+      if (pollFDs[0].revents & POLLIN) {
+        uint8_t wakeUpBytes[64];
+        while (read(this->wakeUpPipe[0],
+                    wakeUpBytes,
+                    sizeof(wakeUpBytes)) > 0) {}
+      }
+
+      for (int i = 0; i < polledConnections.size(); i++) {
+        Connection& connection = *polledConnections[i];
+        const short events = pollFDs[i + 2].revents;
+        if (events == 0) {
+          continue;
+        }
+
+        const bool isOutgoing = &connection == &this->nextIslandConnection
+                                || &connection == &this->coordinatorConnection;
+        if (!isOutgoing) {
+          const bool isOpen = this->readConnection(connection);
+          if (!this->handleMessages(connection) || !isOpen) {
+            this->closeConnection(connection);
+          }
+
+          continue;
+        }
+
+        if (connection.isConnecting) {
+          int error = 0;
+          socklen_t errorLength = sizeof(error);
+          getsockopt(connection.socket,
+                     SOL_SOCKET,
+                     SO_ERROR,
+                     &error,
+                     &errorLength);
+          if (error != 0) {
+            // Nothing has been sent yet, so keep the messages for the next
+            // connection attempt.
+            this->closeConnection(connection);
+            continue;
+          }
+
+          connection.isConnecting = false;
+        }
+
+        // Islands never send anything back on our outgoing connections, so
+        // the connection being readable means that it has been closed.
+        // Messages that were partly sent cannot be resumed on a new
+        // connection, so drop them all.
+        if ((events & (POLLIN | POLLERR | POLLHUP))
+            || ((events & POLLOUT) && !this->flushConnection(connection))) {
+          this->closeConnection(connection);
+          connection.outBuffer.clear();
+        }
+      }
+
+      this->incomingConnections.erase(
+          std::remove_if(this->incomingConnections.begin(),
+                         this->incomingConnections.end(),
+                         [](const Connection& connection) {
+                           return connection.socket < 0;
+                         }),
+          this->incomingConnections.end());
+
+      if (pollFDs[1].revents & POLLIN) {
+        int socket = -1;
+        while ((socket = accept(this->listeningSocket, nullptr, nullptr))
+               >= 0) {
+          makeNonBlocking(socket);
+          this->incomingConnections.push_back(
+              Connection{ socket, false, {}, {} });
+        }
+      }
+    }
+
+    this->closeConnection(this->nextIslandConnection);
+    this->closeConnection(this->coordinatorConnection);
+    for (Connection& connection : this->incomingConnections) {
+      this->closeConnection(connection);
+    }
+
+    this->incomingConnections.clear();
+  }
+
+  void Island::connectToIsland(Connection& connection, const int islandIndex)
+  {
+    sockaddr_storage socketAddress;
+    socklen_t socketAddressLength = 0;
+    if (!parseAddress(this->addresses[islandIndex],
+                      socketAddress,
+                      socketAddressLength)) {
+      // The address will never become valid, so don't keep the messages.
+      connection.outBuffer.clear();
+      return;
+    }
+
+    connection.socket = socket(socketAddress.ss_family, SOCK_STREAM, 0);
+    if (connection.socket < 0) {
+      return;
+    }
+
+    if (!makeNonBlocking(connection.socket)) {
+      this->closeConnection(connection);
+      return;
+    }
+
+    if (connect(connection.socket,
+                reinterpret_cast<const sockaddr*>(&socketAddress),
+                socketAddressLength) == 0) {
+      connection.isConnecting = false;
+    } else if (errno == EINPROGRESS) {
+      connection.isConnecting = true;
+    } else {
+      this->closeConnection(connection);
+    }
+  }
+
+  bool Island::flushConnection(Connection& connection)
+  {
+    size_t numSentBytes = 0;
+    while (numSentBytes < connection.outBuffer.size()) {
+      const ssize_t result = send(connection.socket,
+                                  connection.outBuffer.data() + numSentBytes,
+                                  connection.outBuffer.size() - numSentBytes,
+                                  MSG_NOSIGNAL);
+      if (result > 0) {
+        numSentBytes += static_cast<size_t>(result);
+      } else if (result < 0 && errno == EINTR) {
+        continue;
+      } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      } else {
+        return false;
+      }
+    }
+
+    connection.outBuffer.erase(connection.outBuffer.begin(),
+                               connection.outBuffer.begin() + numSentBytes);
+    return true;
+  }
+
+  bool Island::readConnection(Connection& connection)
+  {
+    uint8_t chunk[64 * 1024];
+    while (true) {
+      const ssize_t result = recv(connection.socket, chunk, sizeof(chunk), 0);
+      if (result > 0) {
+        connection.inBuffer.insert(connection.inBuffer.end(),
+                                   chunk,
+                                   chunk + result);
+      } else if (result < 0 && errno == EINTR) {
+        continue;
+      } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return true;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  bool Island::handleMessages(Connection& connection)
+  {
+    const uint8_t* const bufferStart = connection.inBuffer.data();
+    const uint8_t* const bufferEnd = bufferStart
+                                     + connection.inBuffer.size();
+    const uint8_t* cursor = bufferStart;
+    while (static_cast<size_t>(bufferEnd - cursor) >= messageHeaderSize) {
+      const uint8_t* messageCursor = cursor;
+      uint32_t type = 0;
+      uint32_t senderIndex = 0;
+      uint32_t payloadSize = 0;
+      readValue(messageCursor, bufferEnd, type);
+      readValue(messageCursor, bufferEnd, senderIndex);
+      readValue(messageCursor, bufferEnd, payloadSize);
+      if (payloadSize > maxPayloadSize) {
+        return false;
+      }
+
+      if (static_cast<size_t>(bufferEnd - messageCursor) < payloadSize) {
+        break;
+      }
+
+      const uint8_t* const payloadEnd = messageCursor + payloadSize;
+      switch (static_cast<MessageType>(type)) {
+        case MessageType::MIGRANTS: {
+          // The count comes from the peer, so it is checked against the
+          // smallest size the migrants could take up before anything is
+          // allocated for them.
+          constexpr size_t minSolutionSize = sizeof(int32_t) + sizeof(double);
+          uint32_t numMigrants = 0;
+          if (!readValue(messageCursor, payloadEnd, numMigrants)
+              || numMigrants > static_cast<size_t>(payloadEnd - messageCursor)
+                               / minSolutionSize) {
+            return false;
+          }
+
+          eastl::vector<Solution> migrants(numMigrants);
+          for (Solution& migrant : migrants) {
+            if (!readSolution(messageCursor, payloadEnd, migrant)) {
+              return false;
+            }
+          }
+
+          std::lock_guard<std::mutex> lock{ this->mutex };
+          for (Solution& migrant : migrants) {
+            this->receivedMigrants.push_back(eastl::move(migrant));
+          }
+
+          break;
+        }
+        case MessageType::BEST_SOLUTION:
+        case MessageType::FINAL_SOLUTION: {
+          Solution solution;
+          if (!readSolution(messageCursor, payloadEnd, solution)) {
+            return false;
+          }
+
+          if (this->isCoordinator()) {
+            this->recordSolution(
+                static_cast<int>(senderIndex),
+                solution,
+                static_cast<MessageType>(type)
+                == MessageType::FINAL_SOLUTION);
+          }
+
+          break;
+        }
+        default:
+          return false;
+      }
+
+      cursor = payloadEnd;
+    }
+
+    connection.inBuffer.erase(
+        connection.inBuffer.begin(),
+        connection.inBuffer.begin() + (cursor - bufferStart));
+    return true;
+  }
+
+  void Island::closeConnection(Connection& connection)
+  {
+    if (connection.socket >= 0) {
+      ::close(connection.socket);
+    }
+
+    connection.socket = -1;
+    connection.isConnecting = false;
+    connection.inBuffer.clear();
+  }
+
+  void Island::wakeUpIOLoop()
+  {
+    if (this->wakeUpPipe[1] >= 0) {
+      const uint8_t wakeUpByte = 0;
+      // The pipe being full already means that the loop will wake up.
+      (void) write(this->wakeUpPipe[1], &wakeUpByte, 1);
+    }
+  }
+}
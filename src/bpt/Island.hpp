@@ -0,0 +1,114 @@
+#ifndef BPT_ISLAND_HPP
+#define BPT_ISLAND_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Solution.hpp>
+
+namespace bpt
+{
+  // One island of a distributed island model. Each process runs the GA on
+  // its own population as one island (see GA::setIsland()), and the islands
+  // exchange migrants in a ring, with island i sending its migrants to
+  // island (i + 1) % numIslands. Island 0 is also the coordinator, to which
+  // every island reports its best solution.
+  //
+  // Islands talk over TCP ("host:port") or Unix domain sockets
+  // ("unix:path"). All socket I/O happens on a background thread, so
+  // sending and receiving never blocks the GA. Migration is best effort:
+  // migrants that cannot be delivered are dropped. Solutions are sent in the
+  // byte order of the host, so all islands must share the same byte order.
+  class Island
+  {
+  public:
+    Island(const int islandIndex,
+           const eastl::vector<eastl::string>& addresses,
+           const int numMigrants,
+           const int migrationInterval);
+    ~Island();
+
+    Island(const Island& other) = delete;
+    Island& operator=(const Island& other) = delete;
+
+    // Starts listening on the address of this island. Returns false if the
+    // address is invalid or cannot be listened on.
+    bool open();
+    // Stops the island, after giving pending messages a moment to be sent.
+    void close();
+
+    int getIslandIndex() const;
+    int getNumIslands() const;
+    int getNumMigrants() const;
+    int getMigrationInterval() const;
+    bool isCoordinator() const;
+
+    void sendMigrants(const eastl::vector<Solution>& migrants);
+    // Returns the migrants received since the last call.
+    eastl::vector<Solution> receiveMigrants();
+    void reportBestSolution(const Solution& solution);
+    void reportFinalSolution(const Solution& solution);
+
+    // Coordinator only. The global best solution is the best of those that
+    // the islands have reported so far.
+    bool hasGlobalBestSolution();
+    Solution getGlobalBestSolution();
+    // Waits until every island has reported its final solution, or until
+    // the timeout passes. A negative timeout waits forever. Returns whether
+    // every island has reported its final solution.
+    bool waitForFinalSolutions(const int timeoutMs);
+  private:
+    struct Connection
+    {
+      int socket;
+      bool isConnecting;
+      eastl::vector<uint8_t> inBuffer;
+      eastl::vector<uint8_t> outBuffer;
+    };
+
+    void queueMessage(eastl::vector<uint8_t>& pendingBytes,
+                      const eastl::vector<uint8_t>& message);
+    void recordSolution(const int islandIndex,
+                        const Solution& solution,
+                        const bool isFinal);
+    void runIOLoop();
+    void connectToIsland(Connection& connection, const int islandIndex);
+    bool flushConnection(Connection& connection);
+    bool readConnection(Connection& connection);
+    bool handleMessages(Connection& connection);
+    void closeConnection(Connection& connection);
+    void wakeUpIOLoop();
+
+    int islandIndex;
+    eastl::vector<eastl::string> addresses;
+    int numMigrants;
+    int migrationInterval;
+    int listeningSocket;
+    int wakeUpPipe[2];
+    std::thread ioThread;
+    std::atomic<bool> isStopping;
+
+    // Guarded by mutex.
+    std::mutex mutex;
+    std::condition_variable finalSolutionsCondition;
+    eastl::vector<uint8_t> pendingNextIslandBytes;
+    eastl::vector<uint8_t> pendingCoordinatorBytes;
+    eastl::vector<Solution> receivedMigrants;
+    eastl::vector<Solution> bestSolutions;
+    eastl::vector<bool> hasBestSolution;
+    eastl::vector<bool> hasFinalSolution;
+
+    // Only used by the I/O thread.
+    Connection nextIslandConnection;
+    Connection coordinatorConnection;
+    eastl::vector<Connection> incomingConnections;
+  };
+}
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef BPT_MUTATION_SELECTION_TYPE
+#define BPT_MUTATION_SELECTION_TYPE
+
+namespace bpt
+{
+  enum class MutationSelectionType { UNIFORM, ADAPTIVE };
+}
+
+#endif
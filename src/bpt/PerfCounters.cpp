@@ -0,0 +1,259 @@
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <EASTL/array.h>
+
+#include <bpt/GAPhase.hpp>
+#include <bpt/PerfCounters.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+#ifdef __linux__
+    int openPerfEvent(const uint32_t type,
+                      const uint64_t config,
+                      const int groupFD)
+    {
+      perf_event_attr attributes;
+      std::memset(&attributes, 0, sizeof(attributes));
+      attributes.size = sizeof(attributes);
+      attributes.type = type;
+      attributes.config = config;
+      attributes.disabled = (groupFD == -1) ? 1 : 0;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_GROUP
+                               | PERF_FORMAT_TOTAL_TIME_ENABLED
+                               | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      return static_cast<int>(syscall(__NR_perf_event_open,
+                                      &attributes,
+                                      0,
+                                      -1,
+                                      groupFD,
+                                      0));
+    }
+#endif
+  }
+
+  PerfCounters::PerfCounters()
+      : groupFD(-1)
+      , eventFDs{ -1, -1, -1, -1 }
+      , eventValueIndices{ -1, -1, -1, -1 }
+      , numOpenEvents(0)
+      , currentPhase(GAPhase::NUM_GA_PHASES)
+      , prevValues{}
+      , prevTimeEnabled(0)
+      , prevTimeRunning(0)
+      , phaseValues{} {}
+
+  PerfCounters::~PerfCounters()
+  {
+    this->close();
+  }
+
+  bool PerfCounters::open()
+  {
+    if (this->isOpen()) {
+      return true;
+    }
+
+#ifdef __linux__
+    // In the order of the fields of PerfCounts. Cycles lead the group, so
+    // the other events are only counted when cycles are.
+    const eastl::array<uint64_t, numEvents> eventConfigs{
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < numEvents; i++) {
+      this->eventFDs[i] = openPerfEvent(PERF_TYPE_HARDWARE,
+                                        eventConfigs[i],
+                                        this->groupFD);
+      if (this->eventFDs[i] == -1) {
+        if (i == 0) {
+          return false;
+        }
+
+        continue;
+      }
+
+      if (i == 0) {
+        this->groupFD = this->eventFDs[i];
+      }
+
+      this->eventValueIndices[i] = this->numOpenEvents;
+      this->numOpenEvents++;
+    }
+
+    ioctl(this->groupFD, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(this->groupFD, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    this->currentPhase = GAPhase::NUM_GA_PHASES;
+    this->phaseValues = {};
+    if (!this->readEvents(this->prevValues,
+                          this->prevTimeEnabled,
+                          this->prevTimeRunning)) {
+      this->close();
+      return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void PerfCounters::close()
+  {
+#ifdef __linux__
+    for (int& eventFD : this->eventFDs) {
+      if (eventFD != -1) {
+        ::close(eventFD);
+        eventFD = -1;
+      }
+    }
+#endif
+
+    this->groupFD = -1;
+    this->eventValueIndices = { -1, -1, -1, -1 };
+    this->numOpenEvents = 0;
+  }
+
+  bool PerfCounters::isOpen() const
+  {
+    return this->groupFD != -1;
+  }
+
+  GAPhase PerfCounters::switchPhase(const GAPhase phase)
+  {
+    const GAPhase prevPhase = this->currentPhase;
+
+    eastl::array<uint64_t, numEvents> values;
+    uint64_t timeEnabled = 0;
+    uint64_t timeRunning = 0;
+    if (this->readEvents(values, timeEnabled, timeRunning)) {
+      // The group did not run at all if it was multiplexed out for the
+      // whole time, in which case there is nothing to scale.
+      const uint64_t timeEnabledDelta = timeEnabled - this->prevTimeEnabled;
+      const uint64_t timeRunningDelta = timeRunning - this->prevTimeRunning;
+      if (prevPhase != GAPhase::NUM_GA_PHASES && timeRunningDelta > 0) {
+        const double scale = static_cast<double>(timeEnabledDelta)
+                             / static_cast<double>(timeRunningDelta);
+        auto& prevPhaseValues = this->phaseValues[
+            static_cast<int>(prevPhase)];
+        for (int i = 0; i < numEvents; i++) {
+          prevPhaseValues[i] += static_cast<uint64_t>(
+              static_cast<double>(values[i] - this->prevValues[i]) * scale
+              + 0.5);
+        }
+      }
+
+      this->prevValues = values;
+      this->prevTimeEnabled = timeEnabled;
+      this->prevTimeRunning = timeRunning;
+    }
+
+    this->currentPhase = phase;
+    return prevPhase;
+  }
+
+  GAPhase PerfCounters::getCurrentPhase() const
+  {
+    return this->currentPhase;
+  }
+
+  eastl::array<PerfCounts, numGAPhases> PerfCounters::takeCounts()
+  {
+    // Attribute what the current phase counted so far.
+    this->switchPhase(this->currentPhase);
+
+    eastl::array<PerfCounts, numGAPhases> counts;
+    for (int i = 0; i < numGAPhases; i++) {
+      const auto& values = this->phaseValues[i];
+      auto getCount = [&](int eventIndex) -> int64_t {
+        return (this->eventValueIndices[eventIndex] == -1)
+               ? -1
+               : static_cast<int64_t>(values[eventIndex]);
+      };
+
+      counts[i] = PerfCounts{
+        getCount(0),
+        getCount(1),
+        getCount(2),
+        getCount(3)
+      };
+    }
+
+    this->phaseValues = {};
+    return counts;
+  }
+
+  bool PerfCounters::readEvents(eastl::array<uint64_t, numEvents>& values,
+                                uint64_t& timeEnabled,
+                                uint64_t& timeRunning)
+  {
+    if (!this->isOpen()) {
+      return false;
+    }
+
+#ifdef __linux__
+    // With PERF_FORMAT_GROUP, the number of events comes first, followed by
+    // the times the group was enabled and running, and the values of the
+    // events in the order they were opened.
+    constexpr int numHeaderValues = 3;
+    eastl::array<uint64_t, numHeaderValues + numEvents> buffer;
+    const ssize_t numBytesRead = read(this->groupFD,
+                                      buffer.data(),
+                                      sizeof(buffer));
+    const auto numExpectedBytes = static_cast<ssize_t>(
+        sizeof(uint64_t) * (numHeaderValues + this->numOpenEvents));
+    if (numBytesRead < numExpectedBytes
+        || buffer[0] != static_cast<uint64_t>(this->numOpenEvents)) {
+      return false;
+    }
+
+    timeEnabled = buffer[1];
+    timeRunning = buffer[2];
+    for (int i = 0; i < numEvents; i++) {
+      const int valueIndex = this->eventValueIndices[i];
+      values[i] = (valueIndex == -1)
+                  ? 0
+                  : buffer[numHeaderValues + valueIndex];
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  PerfPhaseScope::PerfPhaseScope(PerfCounters* counters, const GAPhase phase)
+      : counters((counters != nullptr
+                  && counters->isOpen()
+                  && counters->getCurrentPhase() == GAPhase::NUM_GA_PHASES)
+                 ? counters
+                 : nullptr)
+  {
+    if (this->counters != nullptr) {
+      this->counters->switchPhase(phase);
+    }
+  }
+
+  PerfPhaseScope::~PerfPhaseScope()
+  {
+    if (this->counters != nullptr) {
+      this->counters->switchPhase(GAPhase::NUM_GA_PHASES);
+    }
+  }
+}
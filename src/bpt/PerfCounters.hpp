@@ -0,0 +1,91 @@
+#ifndef BPT_PERF_COUNTERS_HPP
+#define BPT_PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+#include <EASTL/array.h>
+
+#include <bpt/GAPhase.hpp>
+
+namespace bpt
+{
+  constexpr int numGAPhases = static_cast<int>(GAPhase::NUM_GA_PHASES);
+
+  // Counts of a counter that could not be opened are -1.
+  struct PerfCounts
+  {
+    int64_t cycles;
+    int64_t instructions;
+    int64_t llcMisses;
+    int64_t branchMisses;
+  };
+
+  // Hardware performance counters of the calling thread, read with Linux
+  // perf_event_open(). Counts are attributed to the outermost phase that is
+  // current. Phases nested in another one, e.g. the feasibility checks and
+  // fitness evaluations that operators make in their retry loops, are
+  // counted as part of it, so that reading the counters, which takes a
+  // system call, does not happen in inner loops and disturb what is being
+  // measured. When the kernel multiplexes the counters, counts are scaled
+  // up by how long they were enabled over how long they actually ran. Only
+  // user-space events are counted, which works with the default
+  // perf_event_paranoid setting of 2.
+  class PerfCounters
+  {
+  public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters& other) = delete;
+    PerfCounters& operator=(const PerfCounters& other) = delete;
+
+    // Returns false if no counters are available, e.g. when not on Linux,
+    // in some virtual machines or containers, or when perf_event_paranoid
+    // is set to 3 or higher. Counters that only some CPUs have may be
+    // unavailable even if open() succeeds.
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    // Makes the given phase current, and returns the previously current
+    // one. Passing NUM_GA_PHASES makes no phase current.
+    GAPhase switchPhase(const GAPhase phase);
+    GAPhase getCurrentPhase() const;
+    // Returns the counts per phase since the last call, in the order of
+    // GAPhase.
+    eastl::array<PerfCounts, numGAPhases> takeCounts();
+  private:
+    static constexpr int numEvents = 4;
+
+    bool readEvents(eastl::array<uint64_t, numEvents>& values,
+                    uint64_t& timeEnabled,
+                    uint64_t& timeRunning);
+
+    int groupFD;
+    eastl::array<int, numEvents> eventFDs;
+    // Position of each open event in the values read from the group.
+    eastl::array<int, numEvents> eventValueIndices;
+    int numOpenEvents;
+    GAPhase currentPhase;
+    eastl::array<uint64_t, numEvents> prevValues;
+    uint64_t prevTimeEnabled;
+    uint64_t prevTimeRunning;
+    eastl::array<eastl::array<uint64_t, numEvents>, numGAPhases> phaseValues;
+  };
+
+  // Makes a phase current for the lifetime of the scope. Does nothing if
+  // the counters are null or not open, or if another phase is current.
+  class PerfPhaseScope
+  {
+  public:
+    PerfPhaseScope(PerfCounters* counters, const GAPhase phase);
+    ~PerfPhaseScope();
+
+    PerfPhaseScope(const PerfPhaseScope& other) = delete;
+    PerfPhaseScope& operator=(const PerfPhaseScope& other) = delete;
+  private:
+    PerfCounters* counters;
+  };
+}
+
+#endif
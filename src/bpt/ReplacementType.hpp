@@ -0,0 +1,9 @@
+#ifndef BPT_REPLACEMENT_TYPE
+#define BPT_REPLACEMENT_TYPE
+
+namespace bpt
+{
+  enum class ReplacementType { GENERATIONAL, STEADY_STATE };
+}
+
+#endif
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/RunProgress.hpp>
+#include <bpt/ds/Solution.hpp>
+#include <bpt/RunProgressBoard.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    constexpr float noFitness = std::numeric_limits<float>::quiet_NaN();
+  }
+
+  RunProgressBoard::GeneBuffer::GeneBuffer(const int capacity)
+      : capacity(capacity)
+      , genes(new std::atomic<float>[capacity]()) {}
+
+  RunProgressBoard::RunProgressBoard()
+      : sequence(0)
+      , isRunning(false)
+      , generationNumber(-1)
+      , bestFitness(noFitness)
+      , averageFitness(noFitness)
+      , worstFitness(noFitness)
+      , numEvaluations(0)
+      , numCachedEvaluations(0)
+      , numBestSolutionBuildings(0)
+      , bestSolutionFitness(0.0)
+      , geneBuffer(nullptr)
+      , geneBuffers() {}
+
+  void RunProgressBoard::startRun()
+  {
+    this->beginPost();
+
+    constexpr auto order = std::memory_order_relaxed;
+    this->isRunning.store(true, order);
+    this->generationNumber.store(-1, order);
+    this->bestFitness.store(noFitness, order);
+    this->averageFitness.store(noFitness, order);
+    this->worstFitness.store(noFitness, order);
+    this->numEvaluations.store(0, order);
+    this->numCachedEvaluations.store(0, order);
+    this->numBestSolutionBuildings.store(0, order);
+    this->bestSolutionFitness.store(0.0, order);
+
+    this->endPost();
+  }
+
+  void RunProgressBoard::postProgress(const int generationNumber,
+                                      const float bestFitness,
+                                      const float averageFitness,
+                                      const float worstFitness,
+                                      const uint64_t numEvaluations,
+                                      const uint64_t numCachedEvaluations,
+                                      const Solution* bestSolution)
+  {
+    const int numBuildings = (bestSolution != nullptr)
+                             ? bestSolution->getNumBuildings()
+                             : 0;
+
+    this->beginPost();
+
+    // Replacing the buffer has to be part of the post, so that readers
+    // notice it.
+    this->reserveGenes(numBuildings * 3);
+
+    constexpr auto order = std::memory_order_relaxed;
+    this->generationNumber.store(generationNumber, order);
+    this->bestFitness.store(bestFitness, order);
+    this->averageFitness.store(averageFitness, order);
+    this->worstFitness.store(worstFitness, order);
+    this->numEvaluations.store(numEvaluations, order);
+    this->numCachedEvaluations.store(numCachedEvaluations, order);
+    this->numBestSolutionBuildings.store(numBuildings, order);
+
+    if (bestSolution != nullptr) {
+      this->bestSolutionFitness.store(bestSolution->getFitness(), order);
+
+      // Compact genes are decoded here, so readers need no quantizer.
+      std::atomic<float>* genes = this->geneBuffers.back()->genes.get();
+      for (int i = 0; i < numBuildings; i++) {
+        genes[(i * 3)].store(bestSolution->getBuildingXPos(i), order);
+        genes[(i * 3) + 1].store(bestSolution->getBuildingYPos(i), order);
+        genes[(i * 3) + 2].store(bestSolution->getBuildingRotation(i), order);
+      }
+    }
+
+    this->endPost();
+  }
+
+  void RunProgressBoard::finishRun()
+  {
+    this->beginPost();
+    this->isRunning.store(false, std::memory_order_relaxed);
+    this->endPost();
+  }
+
+  RunProgress RunProgressBoard::readProgress() const
+  {
+    RunProgress progress;
+    eastl::vector<float> genes;
+    double solutionFitness = 0.0;
+
+    constexpr auto order = std::memory_order_relaxed;
+    while (true) {
+      const uint32_t startSequence = this->sequence.load(
+          std::memory_order_acquire);
+      if ((startSequence & 1) != 0) {
+        // A post is under way.
+        std::this_thread::yield();
+        continue;
+      }
+
+      progress.isRunning = this->isRunning.load(order);
+      progress.generationNumber = this->generationNumber.load(order);
+      progress.bestFitness = this->bestFitness.load(order);
+      progress.averageFitness = this->averageFitness.load(order);
+      progress.worstFitness = this->worstFitness.load(order);
+      progress.numEvaluations = this->numEvaluations.load(order);
+      progress.numCachedEvaluations = this->numCachedEvaluations.load(order);
+      solutionFitness = this->bestSolutionFitness.load(order);
+
+      // The buffer and the number of genes may not match in a torn copy,
+      // so the copy is bounded by the capacity of the buffer itself.
+      const GeneBuffer* buffer = this->geneBuffer.load(
+          std::memory_order_acquire);
+      int numGenes = this->numBestSolutionBuildings.load(order) * 3;
+      numGenes = (buffer != nullptr)
+                 ? std::min(numGenes, buffer->capacity)
+                 : 0;
+      genes.resize(numGenes);
+      for (int i = 0; i < numGenes; i++) {
+        genes[i] = buffer->genes[i].load(order);
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (this->sequence.load(order) == startSequence) {
+        break;
+      }
+    }
+
+    const int numBuildings = static_cast<int>(genes.size()) / 3;
+    if (numBuildings > 0) {
+      progress.bestSolution = Solution{ numBuildings };
+      for (int i = 0; i < numBuildings; i++) {
+        progress.bestSolution.setBuildingXPos(i, genes[(i * 3)]);
+        progress.bestSolution.setBuildingYPos(i, genes[(i * 3) + 1]);
+        progress.bestSolution.setBuildingRotation(i, genes[(i * 3) + 2]);
+      }
+
+      progress.bestSolution.setFitness(solutionFitness);
+    }
+
+    return progress;
+  }
+
+  void RunProgressBoard::beginPost()
+  {
+    const uint32_t sequence = this->sequence.load(std::memory_order_relaxed);
+    this->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void RunProgressBoard::endPost()
+  {
+    const uint32_t sequence = this->sequence.load(std::memory_order_relaxed);
+    this->sequence.store(sequence + 1, std::memory_order_release);
+  }
+
+  void RunProgressBoard::reserveGenes(const int numGenes)
+  {
+    if (numGenes == 0
+        || (!this->geneBuffers.empty()
+            && this->geneBuffers.back()->capacity >= numGenes)) {
+      return;
+    }
+
+    int capacity = this->geneBuffers.empty()
+                   ? numGenes
+                   : this->geneBuffers.back()->capacity;
+    while (capacity < numGenes) {
+      capacity *= 2;
+    }
+
+    this->geneBuffers.push_back(std::make_unique<GeneBuffer>(capacity));
+    this->geneBuffer.store(this->geneBuffers.back().get(),
+                           std::memory_order_release);
+  }
+}
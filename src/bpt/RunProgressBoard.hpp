@@ -0,0 +1,82 @@
+#ifndef BPT_RUN_PROGRESS_BOARD_HPP
+#define BPT_RUN_PROGRESS_BOARD_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/RunProgress.hpp>
+#include <bpt/ds/Solution.hpp>
+
+namespace bpt
+{
+  // Latest progress of a GA run, posted by the thread running it once per
+  // generation, and read by any number of other threads, e.g. to show the
+  // best layout so far on a dashboard while the run goes on. Neither side
+  // ever takes a lock, so reading as often as wanted does not hold up the
+  // run.
+  //
+  // The progress is guarded by a sequence lock. The poster makes the
+  // sequence number odd, writes the progress, and makes it even again.
+  // Readers copy the progress out, and retry if the sequence number was odd
+  // or changed while they were copying. Every field is a relaxed atomic, so
+  // torn copies are thrown away rather than being data races.
+  //
+  // The genes of the best solution go into a buffer sized for it. A buffer
+  // is only replaced by a larger one, and old buffers are kept until the
+  // board is destroyed, so a reader racing a replacement never reads freed
+  // memory. Buffers double in size, so they take at most about twice the
+  // memory of the largest solution posted.
+  class RunProgressBoard
+  {
+  public:
+    RunProgressBoard();
+
+    // Poster side. Only one thread may post at a time.
+    // Clears the progress of the previous run.
+    void startRun();
+    // bestSolution may be nullptr if the run has no best solution yet.
+    void postProgress(const int generationNumber,
+                      const float bestFitness,
+                      const float averageFitness,
+                      const float worstFitness,
+                      const uint64_t numEvaluations,
+                      const uint64_t numCachedEvaluations,
+                      const Solution* bestSolution);
+    // The progress of the run stays readable after it is finished.
+    void finishRun();
+
+    // Reader side. Safe to call from any thread.
+    RunProgress readProgress() const;
+  private:
+    struct GeneBuffer
+    {
+      explicit GeneBuffer(const int capacity);
+
+      const int capacity;
+      std::unique_ptr<std::atomic<float>[]> genes;
+    };
+
+    void beginPost();
+    void endPost();
+    void reserveGenes(const int numGenes);
+
+    std::atomic<uint32_t> sequence;
+    std::atomic<bool> isRunning;
+    std::atomic<int> generationNumber;
+    std::atomic<float> bestFitness;
+    std::atomic<float> averageFitness;
+    std::atomic<float> worstFitness;
+    std::atomic<uint64_t> numEvaluations;
+    std::atomic<uint64_t> numCachedEvaluations;
+    std::atomic<int> numBestSolutionBuildings;
+    std::atomic<double> bestSolutionFitness;
+    std::atomic<const GeneBuffer*> geneBuffer;
+    // Only accessed by the poster.
+    eastl::vector<std::unique_ptr<GeneBuffer>> geneBuffers;
+  };
+}
+
+#endif
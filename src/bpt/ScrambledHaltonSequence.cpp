@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <bpt/random.hpp>
+#include <bpt/ScrambledHaltonSequence.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    constexpr int primes[ScrambledHaltonSequence::maxNumDimensions] = {
+      2, 3, 5, 7, 11, 13, 17, 19
+    };
+
+    // Enough digits to reach the precision of a float in every base.
+    int computeNumDigits(const int base)
+    {
+      return static_cast<int>(std::ceil(24.0 / std::log2(base)));
+    }
+  }
+
+  ScrambledHaltonSequence::ScrambledHaltonSequence()
+      : ScrambledHaltonSequence(0) {}
+
+  ScrambledHaltonSequence::ScrambledHaltonSequence(const int numDimensions)
+      : numDimensions(numDimensions)
+      , pointIndex(0)
+      , digitPermutations(numDimensions)
+  {
+    assert(numDimensions >= 0 && numDimensions <= maxNumDimensions);
+
+    for (int k = 0; k < numDimensions; k++) {
+      const int base = primes[k];
+      const int numDigits = computeNumDigits(base);
+      eastl::vector<uint8_t>& permutations = this->digitPermutations[k];
+      permutations.resize(numDigits * base);
+      for (int j = 0; j < numDigits; j++) {
+        auto permutation = permutations.begin() + (j * base);
+        for (int digit = 0; digit < base; digit++) {
+          permutation[digit] = static_cast<uint8_t>(digit);
+        }
+
+        std::shuffle(permutation, permutation + base, getRandomEngine());
+      }
+    }
+  }
+
+  int ScrambledHaltonSequence::getNumDimensions() const
+  {
+    return this->numDimensions;
+  }
+
+  void ScrambledHaltonSequence::generateNextPoint(float* point)
+  {
+    // The largest float below 1, since rounding may otherwise reach 1.
+    constexpr float maxCoordinate = 1.f - (1.f / 16777216.f);
+
+    for (int k = 0; k < this->numDimensions; k++) {
+      const int base = primes[k];
+      const uint8_t* permutations = this->digitPermutations[k].data();
+      const int numDigits = static_cast<int>(
+          this->digitPermutations[k].size()) / base;
+
+      // Every digit position is scrambled, including the leading zeroes,
+      // so that the points do not all start at the origin.
+      uint64_t index = this->pointIndex;
+      double digitWeight = 1.0 / base;
+      double coordinate = 0.0;
+      for (int j = 0; j < numDigits; j++) {
+        const int digit = static_cast<int>(index % base);
+        index /= base;
+        coordinate += permutations[(j * base) + digit] * digitWeight;
+        digitWeight /= base;
+      }
+
+      point[k] = std::min(static_cast<float>(coordinate), maxCoordinate);
+    }
+
+    this->pointIndex++;
+  }
+}
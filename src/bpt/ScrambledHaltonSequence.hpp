@@ -0,0 +1,37 @@
+#ifndef BPT_SCRAMBLED_HALTON_SEQUENCE_HPP
+#define BPT_SCRAMBLED_HALTON_SEQUENCE_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Low-discrepancy sequence of points in [0, 1)^d. Dimension k is the
+  // radical inverse of the point index in the k-th prime base, with the
+  // digit at each position mapped through a random permutation of the
+  // digits of the base. Scrambling breaks up the correlations between
+  // dimensions that plain Halton sequences have, and makes independently
+  // scrambled sequences cover the same space differently. The permutations
+  // are drawn from the random engine of the calling thread.
+  class ScrambledHaltonSequence
+  {
+  public:
+    static constexpr int maxNumDimensions = 8;
+
+    ScrambledHaltonSequence();
+    ScrambledHaltonSequence(const int numDimensions);
+
+    int getNumDimensions() const;
+    // Writes the coordinates of the next point to point[0, numDimensions).
+    void generateNextPoint(float* point);
+  private:
+    int numDimensions;
+    uint64_t pointIndex;
+    // Permutation of the digits at position j of dimension k, as
+    // digitPermutations[k][(j * base) + digit].
+    eastl::vector<eastl::vector<uint8_t>> digitPermutations;
+  };
+}
+
+#endif
@@ -1,8 +1,27 @@
 #ifndef BPT_BPT_HPP
 #define BPT_BPT_HPP
 
+#include <bpt/AdaptiveOperatorSelector.hpp>
+#include <bpt/ConstraintHandlingType.hpp>
 #include <bpt/ds.hpp>
 #include <bpt/GA.hpp>
+#include <bpt/GAEngine.hpp>
+#include <bpt/GAParameters.hpp>
+#include <bpt/GAPhase.hpp>
+#include <bpt/GeneEncoding.hpp>
+#include <bpt/InitializationType.hpp>
+#include <bpt/ReplacementType.hpp>
+#include <bpt/geometry.hpp>
+#include <bpt/io.hpp>
+#include <bpt/Island.hpp>
+#include <bpt/MutationSelectionType.hpp>
+#include <bpt/operators.hpp>
+#include <bpt/pareto.hpp>
+#include <bpt/PerfCounters.hpp>
+#include <bpt/random.hpp>
+#include <bpt/RunProgressBoard.hpp>
+#include <bpt/ScrambledHaltonSequence.hpp>
 #include <bpt/SelectionType.hpp>
+#include <bpt/tracing.hpp>
 
 #endif
@@ -1,7 +1,20 @@
 #ifndef BPT_DS_HPP
 #define BPT_DS_HPP
 
+#include <bpt/ds/FitnessCache.hpp>
+#include <bpt/ds/FlowMatrix.hpp>
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/FootprintTable.hpp>
+#include <bpt/ds/GeneQuantizer.hpp>
 #include <bpt/ds/InputBuilding.hpp>
+#include <bpt/ds/MinMaxHeap.hpp>
+#include <bpt/ds/PolygonRTree.hpp>
+#include <bpt/ds/Problem.hpp>
+#include <bpt/ds/ProblemChange.hpp>
+#include <bpt/ds/ProblemInstance.hpp>
+#include <bpt/ds/RunProgress.hpp>
+#include <bpt/ds/RunResult.hpp>
+#include <bpt/ds/SiteBoundary.hpp>
 #include <bpt/ds/Solution.hpp>
 
 #endif
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#include <bpt/ds/FitnessCache.hpp>
+#include <bpt/ds/Solution.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    // Quantization steps of the genes. Layouts that differ by less than
+    // these are considered the same layout.
+    constexpr float positionQuantum = 1e-4f;
+    constexpr float rotationQuantum = 1e-3f;
+
+    uint64_t mixHash(uint64_t hash, int64_t value)
+    {
+      // Based on the finalizer of SplitMix64.
+      uint64_t x = hash ^ (static_cast<uint64_t>(value)
+                           + 0x9E3779B97F4A7C15ull
+                           + (hash << 6)
+                           + (hash >> 2));
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      return x ^ (x >> 31);
+    }
+
+    int64_t quantize(float value, float quantum)
+    {
+      return static_cast<int64_t>(std::llround(value / quantum));
+    }
+  }
+
+  FitnessCache::FitnessCache(int capacity)
+      : shards()
+      , capacity(capacity)
+      , numLookups(0)
+      , numHits(0)
+  {
+    const int shardCapacity = std::max(1, capacity / numShards);
+    for (Shard& shard : this->shards) {
+      shard.capacity = shardCapacity;
+      shard.clockHand = 0;
+      shard.entries.reserve(shardCapacity);
+    }
+  }
+
+  uint64_t FitnessCache::computeSolutionKey(const Solution& solution)
+  {
+    uint64_t hash = static_cast<uint64_t>(solution.getNumBuildings());
+    for (int i = 0; i < solution.getNumBuildings(); i++) {
+      hash = mixHash(hash, quantize(solution.getBuildingXPos(i),
+                                    positionQuantum));
+      hash = mixHash(hash, quantize(solution.getBuildingYPos(i),
+                                    positionQuantum));
+      hash = mixHash(hash, quantize(solution.getBuildingRotation(i),
+                                    rotationQuantum));
+    }
+
+    return hash;
+  }
+
+  bool FitnessCache::findFitness(uint64_t key, double& fitness)
+  {
+    this->numLookups++;
+
+    Shard& shard = this->getShard(key);
+    std::lock_guard<std::mutex> lock{ shard.mutex };
+    auto iter = shard.entryIndices.find(key);
+    if (iter == shard.entryIndices.end()) {
+      return false;
+    }
+
+    Entry& entry = shard.entries[iter->second];
+    entry.isReferenced = true;
+    fitness = entry.fitness;
+
+    this->numHits++;
+
+    return true;
+  }
+
+  void FitnessCache::insertFitness(uint64_t key, double fitness)
+  {
+    Shard& shard = this->getShard(key);
+    std::lock_guard<std::mutex> lock{ shard.mutex };
+    auto iter = shard.entryIndices.find(key);
+    if (iter != shard.entryIndices.end()) {
+      Entry& entry = shard.entries[iter->second];
+      entry.fitness = fitness;
+      entry.isReferenced = true;
+      return;
+    }
+
+    if (shard.entries.size() < shard.capacity) {
+      shard.entryIndices[key] = static_cast<int>(shard.entries.size());
+      shard.entries.push_back(Entry{ key, fitness, false });
+      return;
+    }
+
+    // CLOCK eviction. Referenced entries get a second chance.
+    while (shard.entries[shard.clockHand].isReferenced) {
+      shard.entries[shard.clockHand].isReferenced = false;
+      shard.clockHand = (shard.clockHand + 1) % shard.capacity;
+    }
+
+    Entry& victim = shard.entries[shard.clockHand];
+    shard.entryIndices.erase(victim.key);
+    victim = Entry{ key, fitness, false };
+    shard.entryIndices[key] = shard.clockHand;
+    shard.clockHand = (shard.clockHand + 1) % shard.capacity;
+  }
+
+  void FitnessCache::clear()
+  {
+    for (Shard& shard : this->shards) {
+      std::lock_guard<std::mutex> lock{ shard.mutex };
+      shard.entryIndices.clear();
+      shard.entries.clear();
+      shard.clockHand = 0;
+    }
+
+    this->resetStatistics();
+  }
+
+  void FitnessCache::resetStatistics()
+  {
+    this->numLookups = 0;
+    this->numHits = 0;
+  }
+
+  int FitnessCache::getCapacity() const
+  {
+    return this->capacity;
+  }
+
+  uint64_t FitnessCache::getNumLookups() const
+  {
+    return this->numLookups;
+  }
+
+  uint64_t FitnessCache::getNumHits() const
+  {
+    return this->numHits;
+  }
+
+  float FitnessCache::getHitRate() const
+  {
+    const uint64_t numLookups = this->numLookups;
+    if (numLookups == 0) {
+      return 0.f;
+    }
+
+    return static_cast<float>(this->numHits) / static_cast<float>(numLookups);
+  }
+
+  FitnessCache::Shard& FitnessCache::getShard(uint64_t key)
+  {
+    // The low bits are used by the hash map buckets, so use the high bits.
+    return this->shards[(key >> 60) % numShards];
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef BPT_DS_FITNESS_CACHE_HPP
+#define BPT_DS_FITNESS_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <EASTL/array.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Solution.hpp>
+
+namespace bpt
+{
+  // Bounded cache of solution fitnesses, keyed by a hash of the quantized
+  // genes of a solution. The cache is split into shards, each with its own
+  // lock, so it can be shared between threads. Each shard evicts entries
+  // using the CLOCK (second chance) algorithm once it is full.
+  //
+  // Keys are 64-bit hashes, so two different layouts colliding is possible
+  // but improbable enough that we treat a hit as the same layout.
+  class FitnessCache
+  {
+  public:
+    FitnessCache(int capacity);
+
+    static uint64_t computeSolutionKey(const Solution& solution);
+
+    bool findFitness(uint64_t key, double& fitness);
+    void insertFitness(uint64_t key, double fitness);
+    void clear();
+    void resetStatistics();
+    int getCapacity() const;
+    uint64_t getNumLookups() const;
+    uint64_t getNumHits() const;
+    float getHitRate() const;
+  private:
+    struct Entry
+    {
+      uint64_t key;
+      double fitness;
+      bool isReferenced;
+    };
+
+    struct Shard
+    {
+      std::mutex mutex;
+      eastl::hash_map<uint64_t, int> entryIndices;
+      eastl::vector<Entry> entries;
+      int capacity;
+      int clockHand;
+    };
+
+    static constexpr int numShards = 16;
+
+    Shard& getShard(uint64_t key);
+
+    eastl::array<Shard, numShards> shards;
+    int capacity;
+    std::atomic<uint64_t> numLookups;
+    std::atomic<uint64_t> numHits;
+  };
+}
+
+#endif
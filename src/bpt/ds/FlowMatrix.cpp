@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <bpt/ds/FlowMatrix.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    constexpr char fileMagic[4] = { 'B', 'P', 'T', 'F' };
+    constexpr uint32_t byteOrderMark = 0x01020304;
+    constexpr size_t fileHeaderSize = 64;
+    constexpr size_t tileArea = static_cast<size_t>(FlowMatrix::tileSize)
+                                * FlowMatrix::tileSize;
+
+    int computeNumTiles(const int numBuildings)
+    {
+      return (numBuildings + FlowMatrix::tileSize - 1) / FlowMatrix::tileSize;
+    }
+
+    size_t computeNumStoredFlowRates(const int numBuildings)
+    {
+      const auto numTiles = static_cast<size_t>(
+          computeNumTiles(numBuildings));
+      return numTiles * numTiles * tileArea;
+    }
+
+    // Index of a flow rate in the tiled layout.
+    size_t computeFlowRateIndex(const int numTiles,
+                                const int fromBuilding,
+                                const int toBuilding)
+    {
+      constexpr int tileSize = FlowMatrix::tileSize;
+      const size_t tileIndex =
+          (static_cast<size_t>(fromBuilding / tileSize) * numTiles)
+          + (toBuilding / tileSize);
+      return (tileIndex * tileArea)
+             + ((fromBuilding % tileSize) * tileSize)
+             + (toBuilding % tileSize);
+    }
+
+    void writeFileHeader(std::FILE* file, const int numBuildings)
+    {
+      uint8_t header[fileHeaderSize] = {};
+      const uint32_t values[4] = {
+        FlowMatrix::fileVersion,
+        byteOrderMark,
+        static_cast<uint32_t>(numBuildings),
+        static_cast<uint32_t>(FlowMatrix::tileSize)
+      };
+      std::memcpy(header, fileMagic, sizeof(fileMagic));
+      std::memcpy(header + sizeof(fileMagic), values, sizeof(values));
+      std::fwrite(header, 1, sizeof(header), file);
+    }
+
+    bool closeWrittenFile(std::FILE* file)
+    {
+      const bool hasWriteFailed = std::ferror(file) != 0;
+      return (std::fclose(file) == 0) && !hasWriteFailed;
+    }
+  }
+
+  FlowMatrix::Storage::~Storage()
+  {
+    if (this->mapping != nullptr) {
+      munmap(this->mapping, this->mappingSize);
+    }
+  }
+
+  FlowMatrix::FlowMatrix()
+      : storage(nullptr)
+      , flowRates(nullptr)
+      , numBuildings(0)
+      , numTiles(0) {}
+
+  FlowMatrix::FlowMatrix(
+      const eastl::vector<eastl::vector<float>>& flowRates)
+      : FlowMatrix()
+  {
+    this->initialize(static_cast<int>(flowRates.size()));
+
+    auto storage = std::make_shared<Storage>();
+    storage->flowRates.resize(computeNumStoredFlowRates(this->numBuildings),
+                              0.f);
+    for (int i = 0; i < this->numBuildings; i++) {
+      assert(flowRates[i].size() == this->numBuildings);
+      for (int j = 0; j < this->numBuildings; j++) {
+        storage->flowRates[computeFlowRateIndex(this->numTiles, i, j)] =
+            flowRates[i][j];
+      }
+    }
+
+    this->flowRates = storage->flowRates.data();
+    this->storage = std::move(storage);
+  }
+
+  FlowMatrix::FlowMatrix(const int numBuildings, const float* flowRates)
+      : FlowMatrix()
+  {
+    assert(numBuildings >= 0);
+    this->initialize(numBuildings);
+
+    auto storage = std::make_shared<Storage>();
+    storage->flowRates.resize(computeNumStoredFlowRates(numBuildings), 0.f);
+    for (int i = 0; i < numBuildings; i++) {
+      const float* row = flowRates + (static_cast<size_t>(i) * numBuildings);
+      for (int j = 0; j < numBuildings; j++) {
+        storage->flowRates[computeFlowRateIndex(this->numTiles, i, j)] =
+            row[j];
+      }
+    }
+
+    this->flowRates = storage->flowRates.data();
+    this->storage = std::move(storage);
+  }
+
+  bool FlowMatrix::mapFile(const eastl::string& filePath)
+  {
+    const int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      return false;
+    }
+
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) == -1
+        || static_cast<size_t>(fileStatus.st_size) < fileHeaderSize) {
+      close(fd);
+      return false;
+    }
+
+    const auto fileSize = static_cast<size_t>(fileStatus.st_size);
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+
+    // The mapping stays valid after the file is closed.
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      return false;
+    }
+
+    auto storage = std::make_shared<Storage>();
+    storage->mapping = mapping;
+    storage->mappingSize = fileSize;
+
+    const auto* header = static_cast<const uint8_t*>(mapping);
+    uint32_t values[4];
+    std::memcpy(values, header + sizeof(fileMagic), sizeof(values));
+
+    const uint32_t version = values[0];
+    const uint32_t fileByteOrderMark = values[1];
+    const uint32_t numBuildings = values[2];
+    const uint32_t fileTileSize = values[3];
+    if (std::memcmp(header, fileMagic, sizeof(fileMagic)) != 0
+        || version != fileVersion
+        || fileByteOrderMark != byteOrderMark
+        || fileTileSize != tileSize
+        || numBuildings > INT32_MAX - tileSize) {
+      return false;
+    }
+
+    const size_t flowRatesSize = computeNumStoredFlowRates(
+        static_cast<int>(numBuildings)) * sizeof(float);
+    if (fileSize != fileHeaderSize + flowRatesSize) {
+      return false;
+    }
+
+    this->initialize(static_cast<int>(numBuildings));
+    this->flowRates = reinterpret_cast<const float*>(
+        header + fileHeaderSize);
+    this->storage = std::move(storage);
+
+    return true;
+  }
+
+  bool FlowMatrix::writeFile(const eastl::string& filePath) const
+  {
+    std::FILE* file = std::fopen(filePath.c_str(), "wb");
+    if (file == nullptr) {
+      return false;
+    }
+
+    writeFileHeader(file, this->numBuildings);
+    if (this->numBuildings > 0) {
+      std::fwrite(this->flowRates,
+                  sizeof(float),
+                  computeNumStoredFlowRates(this->numBuildings),
+                  file);
+    }
+
+    return closeWrittenFile(file);
+  }
+
+  int FlowMatrix::getNumBuildings() const
+  {
+    return this->numBuildings;
+  }
+
+  int FlowMatrix::getNumTiles() const
+  {
+    return this->numTiles;
+  }
+
+  bool FlowMatrix::isMapped() const
+  {
+    return this->storage != nullptr && this->storage->mapping != nullptr;
+  }
+
+  float FlowMatrix::getFlowRate(const int fromBuilding,
+                                const int toBuilding) const
+  {
+    assert(fromBuilding >= 0 && fromBuilding < this->numBuildings);
+    assert(toBuilding >= 0 && toBuilding < this->numBuildings);
+    return this->flowRates[computeFlowRateIndex(this->numTiles,
+                                                fromBuilding,
+                                                toBuilding)];
+  }
+
+  const float* FlowMatrix::getTile(const int tileRow,
+                                   const int tileColumn) const
+  {
+    assert(tileRow >= 0 && tileRow < this->numTiles);
+    assert(tileColumn >= 0 && tileColumn < this->numTiles);
+    const size_t tileIndex = (static_cast<size_t>(tileRow) * this->numTiles)
+                             + tileColumn;
+    return this->flowRates + (tileIndex * tileArea);
+  }
+
+  void FlowMatrix::initialize(const int numBuildings)
+  {
+    this->numBuildings = numBuildings;
+    this->numTiles = computeNumTiles(numBuildings);
+  }
+
+  bool convertRowMajorFlowMatrixFile(const eastl::string& rowMajorFilePath,
+                                     const int numBuildings,
+                                     const eastl::string& filePath)
+  {
+    assert(numBuildings >= 0);
+
+    std::FILE* rowMajorFile = std::fopen(rowMajorFilePath.c_str(), "rb");
+    if (rowMajorFile == nullptr) {
+      return false;
+    }
+
+    struct stat fileStatus;
+    const size_t rowMajorSize = static_cast<size_t>(numBuildings)
+                                * numBuildings * sizeof(float);
+    if (fstat(fileno(rowMajorFile), &fileStatus) == -1
+        || static_cast<size_t>(fileStatus.st_size) != rowMajorSize) {
+      std::fclose(rowMajorFile);
+      return false;
+    }
+
+    std::FILE* file = std::fopen(filePath.c_str(), "wb");
+    if (file == nullptr) {
+      std::fclose(rowMajorFile);
+      return false;
+    }
+
+    writeFileHeader(file, numBuildings);
+
+    constexpr int tileSize = FlowMatrix::tileSize;
+    const int numTiles = computeNumTiles(numBuildings);
+    eastl::vector<float> band(static_cast<size_t>(tileSize) * numBuildings);
+    eastl::vector<float> tile(tileArea);
+    bool isReadSuccessful = true;
+    for (int tileRow = 0; tileRow < numTiles && isReadSuccessful; tileRow++) {
+      const int numBandRows = std::min(tileSize,
+                                       numBuildings - (tileRow * tileSize));
+      const size_t numBandFlowRates = static_cast<size_t>(numBandRows)
+                                      * numBuildings;
+      isReadSuccessful = std::fread(band.data(),
+                                    sizeof(float),
+                                    numBandFlowRates,
+                                    rowMajorFile) == numBandFlowRates;
+
+      for (int tileColumn = 0; tileColumn < numTiles; tileColumn++) {
+        const int firstColumn = tileColumn * tileSize;
+        const int numTileColumns = std::min(tileSize,
+                                            numBuildings - firstColumn);
+        std::fill(tile.begin(), tile.end(), 0.f);
+        for (int i = 0; i < numBandRows; i++) {
+          std::memcpy(tile.data() + (i * tileSize),
+                      band.data()
+                      + (static_cast<size_t>(i) * numBuildings)
+                      + firstColumn,
+                      sizeof(float) * numTileColumns);
+        }
+
+        std::fwrite(tile.data(), sizeof(float), tile.size(), file);
+      }
+    }
+
+    std::fclose(rowMajorFile);
+
+    const bool isWriteSuccessful = closeWrittenFile(file);
+    return isReadSuccessful && isWriteSuccessful;
+  }
+}
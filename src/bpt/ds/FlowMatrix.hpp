@@ -0,0 +1,85 @@
+#ifndef BPT_DS_FLOW_MATRIX_HPP
+#define BPT_DS_FLOW_MATRIX_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Read-only n x n matrix of the flow rates between buildings, stored in
+  // tiles of tileSize x tileSize flow rates. Tiles are laid out row by row,
+  // and the flow rates within a tile too. Tiles at the right and bottom
+  // edges are padded with zeroes. Going through the matrix tile by tile
+  // keeps the flow rates being read in cache, even when a whole row of the
+  // matrix would not fit.
+  //
+  // The flow rates are either held in memory or memory-mapped from a flow
+  // matrix file, in which case startup does not depend on the size of the
+  // matrix, and pages are only read in once used. Copies share the same
+  // flow rates, and so do processes mapping the same file.
+  //
+  // A flow matrix file starts with a 64-byte header:
+  //   [ "BPTF", format version, byte order mark, n, tile size, padding ]
+  // with each value but the magic being a uint32. The byte order mark is
+  // 0x01020304 in the byte order of the host that wrote the file. The tiles
+  // follow, as floats in the layout above. Files can only be mapped on
+  // hosts with the same byte order and tile size as the one that wrote
+  // them.
+  class FlowMatrix
+  {
+  public:
+    static constexpr int tileSize = 64;
+    static constexpr uint32_t fileVersion = 1;
+
+    FlowMatrix();
+    explicit FlowMatrix(const eastl::vector<eastl::vector<float>>& flowRates);
+    // The flow rates are given in row-major order.
+    FlowMatrix(const int numBuildings, const float* flowRates);
+
+    // Maps the flow matrix file in place of the current flow rates. Returns
+    // false, leaving the matrix as is, if the file cannot be mapped or is
+    // not a valid flow matrix file.
+    bool mapFile(const eastl::string& filePath);
+    // Returns false if the file cannot be written.
+    bool writeFile(const eastl::string& filePath) const;
+
+    int getNumBuildings() const;
+    int getNumTiles() const;
+    bool isMapped() const;
+    float getFlowRate(const int fromBuilding, const int toBuilding) const;
+    // Returns the tileSize * tileSize flow rates of the tile, from
+    // fromBuilding = tileRow * tileSize and toBuilding = tileColumn *
+    // tileSize onwards.
+    const float* getTile(const int tileRow, const int tileColumn) const;
+  private:
+    struct Storage
+    {
+      ~Storage();
+
+      eastl::vector<float> flowRates;
+      void* mapping = nullptr;
+      size_t mappingSize = 0;
+    };
+
+    void initialize(const int numBuildings);
+
+    std::shared_ptr<const Storage> storage;
+    const float* flowRates;
+    int numBuildings;
+    int numTiles;
+  };
+
+  // Writes a flow matrix file from a file of n x n row-major floats, e.g.
+  // one written by numpy.ndarray.tofile(), in the byte order of the host.
+  // Only a band of tileSize rows is held in memory at a time, so matrices
+  // too large to fit in memory twice can be converted. Returns false if
+  // either file cannot be accessed, or if the input has the wrong size.
+  bool convertRowMajorFlowMatrixFile(const eastl::string& rowMajorFilePath,
+                                     const int numBuildings,
+                                     const eastl::string& filePath);
+}
+
+#endif
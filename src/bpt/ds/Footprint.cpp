@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cmath>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+
+namespace bpt
+{
+  Footprint computeBuildingFootprint(const float xPos,
+                                     const float yPos,
+                                     const float rotation,
+                                     const InputBuilding& inputBuilding)
+  {
+    // Let CoreX do the rotation so that our corners follow the same
+    // conventions as its rectangle functions.
+    cx::NPolygon poly = cx::convertRectangleToPolygon(cx::Rectangle{
+        xPos,
+        yPos,
+        inputBuilding.width,
+        inputBuilding.length,
+        rotation
+    });
+
+    Footprint footprint;
+    for (int i = 0; i < 4; i++) {
+      footprint.corners[i] = poly.vertices[i];
+    }
+
+    footprint.center = cx::Point{
+        (footprint.corners[0].x + footprint.corners[2].x) / 2.f,
+        (footprint.corners[0].y + footprint.corners[2].y) / 2.f
+    };
+
+    for (int i = 0; i < 2; i++) {
+      const cx::Vec2 edge = footprint.corners[i + 1] - footprint.corners[i];
+      const float edgeLength = std::sqrt((edge.x * edge.x) + (edge.y * edge.y));
+      footprint.axes[i] = (edgeLength > 0.f)
+                          ? edge / edgeLength
+                          : cx::Vec2{ static_cast<float>(1 - i),
+                                      static_cast<float>(i) };
+      footprint.halfExtents[i] = edgeLength / 2.f;
+    }
+
+    footprint.radius = std::sqrt(
+        (footprint.halfExtents[0] * footprint.halfExtents[0])
+        + (footprint.halfExtents[1] * footprint.halfExtents[1]));
+
+    footprint.minX = footprint.corners[0].x;
+    footprint.maxX = footprint.corners[0].x;
+    footprint.minY = footprint.corners[0].y;
+    footprint.maxY = footprint.corners[0].y;
+    for (int i = 1; i < 4; i++) {
+      footprint.minX = std::min(footprint.minX, footprint.corners[i].x);
+      footprint.maxX = std::max(footprint.maxX, footprint.corners[i].x);
+      footprint.minY = std::min(footprint.minY, footprint.corners[i].y);
+      footprint.maxY = std::max(footprint.maxY, footprint.corners[i].y);
+    }
+
+    return footprint;
+  }
+
+  Footprint translateFootprint(const Footprint& footprint,
+                               const float xOffset,
+                               const float yOffset)
+  {
+    Footprint translatedFootprint = footprint;
+    for (cx::Point& corner : translatedFootprint.corners) {
+      corner.x += xOffset;
+      corner.y += yOffset;
+    }
+
+    translatedFootprint.center.x += xOffset;
+    translatedFootprint.center.y += yOffset;
+    translatedFootprint.minX += xOffset;
+    translatedFootprint.minY += yOffset;
+    translatedFootprint.maxX += xOffset;
+    translatedFootprint.maxY += yOffset;
+
+    return translatedFootprint;
+  }
+}
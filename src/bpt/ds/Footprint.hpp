@@ -0,0 +1,44 @@
+#ifndef BPT_DS_FOOTPRINT_HPP
+#define BPT_DS_FOOTPRINT_HPP
+
+#include <EASTL/array.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/InputBuilding.hpp>
+
+namespace bpt
+{
+  // Precomputed geometry of a placed building. Computing this requires the
+  // trigonometry of the building rotation, so we compute it once per gene
+  // change and reuse it in the feasibility and fitness tests.
+  struct Footprint
+  {
+    // Corners are in the same order as cx::convertRectangleToPolygon().
+    eastl::array<cx::Point, 4> corners;
+    // Unit vectors along the edges corners[0]->corners[1] and
+    // corners[1]->corners[2], with the matching half extents.
+    eastl::array<cx::Vec2, 2> axes;
+    eastl::array<float, 2> halfExtents;
+    cx::Point center;
+    float radius;
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+  };
+
+  Footprint computeBuildingFootprint(const float xPos,
+                                     const float yPos,
+                                     const float rotation,
+                                     const InputBuilding& inputBuilding);
+
+  // Returns the footprint moved by the given offsets. The rotation of a
+  // footprint does not change when it is moved, so this needs no
+  // trigonometry.
+  Footprint translateFootprint(const Footprint& footprint,
+                               const float xOffset,
+                               const float yOffset);
+}
+
+#endif
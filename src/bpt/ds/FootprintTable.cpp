@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/FootprintTable.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    // Rotations within this many degrees of an allowed orientation use its
+    // table entry. This is larger than the rotation step of compact genes.
+    constexpr float orientationTolerance = 0.01f;
+
+    float normalizeRotation(const float rotation)
+    {
+      float normalizedRotation = std::fmod(rotation, 360.f);
+      if (normalizedRotation < 0.f) {
+        normalizedRotation += 360.f;
+      }
+
+      // fmod() of a tiny negative rotation can round up to 360.
+      return (normalizedRotation < 360.f) ? normalizedRotation : 0.f;
+    }
+
+    float computeAngularDistance(const float angleA, const float angleB)
+    {
+      const float difference = std::fabs(angleA - angleB);
+      return std::min(difference, 360.f - difference);
+    }
+  }
+
+  FootprintTable::FootprintTable()
+      : id(generateId())
+      , inputBuildings()
+      , orientations()
+      , footprints() {}
+
+  FootprintTable::FootprintTable(
+      const eastl::vector<InputBuilding>& inputBuildings,
+      const eastl::vector<float>& orientations)
+      : id(generateId())
+      , inputBuildings(inputBuildings)
+      , orientations()
+      , footprints()
+  {
+    for (const float orientation : orientations) {
+      this->orientations.push_back(normalizeRotation(orientation));
+    }
+
+    std::sort(this->orientations.begin(), this->orientations.end());
+    this->orientations.erase(std::unique(this->orientations.begin(),
+                                         this->orientations.end()),
+                             this->orientations.end());
+
+    this->footprints.reserve(inputBuildings.size()
+                             * this->orientations.size());
+    for (const InputBuilding& inputBuilding : inputBuildings) {
+      for (const float orientation : this->orientations) {
+        this->footprints.push_back(computeBuildingFootprint(0.f,
+                                                            0.f,
+                                                            orientation,
+                                                            inputBuilding));
+      }
+    }
+  }
+
+  Footprint FootprintTable::getFootprint(const int buildingIndex,
+                                         const float xPos,
+                                         const float yPos,
+                                         const float rotation) const
+  {
+    if (this->hasOrientations()) {
+      const int orientationIndex = this->findNearestOrientationIndex(
+          rotation);
+      if (computeAngularDistance(normalizeRotation(rotation),
+                                 this->orientations[orientationIndex])
+          <= orientationTolerance) {
+        const int numOrientations = this->getNumOrientations();
+        return translateFootprint(
+            this->footprints[(buildingIndex * numOrientations)
+                             + orientationIndex],
+            xPos,
+            yPos);
+      }
+    }
+
+    return computeBuildingFootprint(xPos,
+                                    yPos,
+                                    rotation,
+                                    this->inputBuildings[buildingIndex]);
+  }
+
+  bool FootprintTable::hasOrientations() const
+  {
+    return !this->orientations.empty();
+  }
+
+  int FootprintTable::getNumOrientations() const
+  {
+    return static_cast<int>(this->orientations.size());
+  }
+
+  float FootprintTable::getOrientation(const int orientationIndex) const
+  {
+    return this->orientations[orientationIndex];
+  }
+
+  int FootprintTable::findNearestOrientationIndex(const float rotation) const
+  {
+    assert(this->hasOrientations());
+
+    const float normalizedRotation = normalizeRotation(rotation);
+    const int numOrientations = this->getNumOrientations();
+
+    // The nearest orientation is either the first one not less than the
+    // rotation or the one before it, wrapping around at 360 degrees.
+    const int nextIndex = static_cast<int>(
+        std::lower_bound(this->orientations.begin(),
+                         this->orientations.end(),
+                         normalizedRotation)
+        - this->orientations.begin()) % numOrientations;
+    const int prevIndex = (nextIndex + numOrientations - 1) % numOrientations;
+
+    const float nextDistance = computeAngularDistance(
+        normalizedRotation, this->orientations[nextIndex]);
+    const float prevDistance = computeAngularDistance(
+        normalizedRotation, this->orientations[prevIndex]);
+    return (prevDistance < nextDistance) ? prevIndex : nextIndex;
+  }
+
+  float FootprintTable::snapRotation(const float rotation) const
+  {
+    if (!this->hasOrientations()) {
+      return rotation;
+    }
+
+    return this->orientations[this->findNearestOrientationIndex(rotation)];
+  }
+
+  uint64_t FootprintTable::getId() const
+  {
+    return this->id;
+  }
+
+  uint64_t FootprintTable::generateId()
+  {
+    static std::atomic<uint64_t> nextId{ 1 };
+    return nextId++;
+  }
+}
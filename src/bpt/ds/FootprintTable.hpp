@@ -0,0 +1,54 @@
+#ifndef BPT_DS_FOOTPRINT_TABLE_HPP
+#define BPT_DS_FOOTPRINT_TABLE_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+
+namespace bpt
+{
+  // Footprints of every input building at every allowed orientation,
+  // computed once at the origin. A footprint at an allowed orientation is
+  // then just a translated table entry, with no trigonometry involved.
+  // Rotations that are not allowed orientations fall back to
+  // computeBuildingFootprint(). With no allowed orientations, every rotation
+  // is allowed and the table is empty.
+  class FootprintTable
+  {
+  public:
+    FootprintTable();
+    FootprintTable(const eastl::vector<InputBuilding>& inputBuildings,
+                   const eastl::vector<float>& orientations);
+
+    Footprint getFootprint(const int buildingIndex,
+                           const float xPos,
+                           const float yPos,
+                           const float rotation) const;
+    bool hasOrientations() const;
+    int getNumOrientations() const;
+    // Orientations are sorted, and normalized to [0, 360).
+    float getOrientation(const int orientationIndex) const;
+    int findNearestOrientationIndex(const float rotation) const;
+    // Returns the allowed orientation nearest to the rotation, or the
+    // rotation itself if every rotation is allowed.
+    float snapRotation(const float rotation) const;
+    // Never zero. Copies share the id of the table they were copied from,
+    // while tables built separately never share one, even if a table takes
+    // up the memory of an earlier one. Footprints cached from a table can
+    // then be tied to it.
+    uint64_t getId() const;
+  private:
+    static uint64_t generateId();
+
+    uint64_t id;
+    eastl::vector<InputBuilding> inputBuildings;
+    eastl::vector<float> orientations;
+    // Footprints of building i are at [i * orientations.size(), ...).
+    eastl::vector<Footprint> footprints;
+  };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <cmath>
+#include <cstdint>
+
+#include <bpt/ds/GeneQuantizer.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    constexpr float maxPositionCode = 65535.f;
+
+    uint16_t encodePosition(float position, float min, float step)
+    {
+      if (!(step > 0.f)) {
+        return 0;
+      }
+
+      const float code = std::round((position - min) / step);
+      if (!(code > 0.f)) {
+        return 0;
+      } else if (code > maxPositionCode) {
+        return static_cast<uint16_t>(maxPositionCode);
+      }
+
+      return static_cast<uint16_t>(code);
+    }
+  }
+
+  GeneQuantizer::GeneQuantizer()
+      : minX(0.f)
+      , minY(0.f)
+      , xStep(0.f)
+      , yStep(0.f) {}
+
+  GeneQuantizer::GeneQuantizer(float minX, float minY, float maxX, float maxY)
+      : minX(minX)
+      , minY(minY)
+      , xStep((maxX - minX) / maxPositionCode)
+      , yStep((maxY - minY) / maxPositionCode) {}
+
+  uint16_t GeneQuantizer::encodeXPos(float xPos) const
+  {
+    return encodePosition(xPos, this->minX, this->xStep);
+  }
+
+  uint16_t GeneQuantizer::encodeYPos(float yPos) const
+  {
+    return encodePosition(yPos, this->minY, this->yStep);
+  }
+
+  uint16_t GeneQuantizer::encodeRotation(float rotation) const
+  {
+    float wrappedRotation = std::fmod(rotation, 360.f);
+    if (wrappedRotation < 0.f) {
+      wrappedRotation += 360.f;
+    }
+
+    // A rotation that rounds up to 360 degrees wraps around to code 0.
+    const auto code = static_cast<uint32_t>(
+        std::lround(wrappedRotation / rotationStep));
+    return static_cast<uint16_t>(code & 0xFFFFu);
+  }
+}
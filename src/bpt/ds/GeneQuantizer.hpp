@@ -0,0 +1,47 @@
+#ifndef BPT_DS_GENE_QUANTIZER_HPP
+#define BPT_DS_GENE_QUANTIZER_HPP
+
+#include <cstdint>
+
+namespace bpt
+{
+  // Converts genes to and from 16-bit fixed-point codes. Positions are
+  // relative to an axis-aligned box, normally the AABB of the site, with each
+  // axis split into 65535 steps. Positions outside the box are clamped to it.
+  // Rotations are split into 65536 steps of 360/65536 degrees, and wrap
+  // around at 360 degrees.
+  class GeneQuantizer
+  {
+  public:
+    GeneQuantizer();
+    GeneQuantizer(float minX, float minY, float maxX, float maxY);
+
+    uint16_t encodeXPos(float xPos) const;
+    uint16_t encodeYPos(float yPos) const;
+    uint16_t encodeRotation(float rotation) const;
+
+    float decodeXPos(uint16_t code) const
+    {
+      return this->minX + (static_cast<float>(code) * this->xStep);
+    }
+
+    float decodeYPos(uint16_t code) const
+    {
+      return this->minY + (static_cast<float>(code) * this->yStep);
+    }
+
+    float decodeRotation(uint16_t code) const
+    {
+      return static_cast<float>(code) * rotationStep;
+    }
+  private:
+    static constexpr float rotationStep = 360.f / 65536.f;
+
+    float minX;
+    float minY;
+    float xStep;
+    float yStep;
+  };
+}
+
+#endif
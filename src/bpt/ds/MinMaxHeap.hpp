@@ -0,0 +1,201 @@
+#ifndef BPT_DS_MIN_MAX_HEAP_HPP
+#define BPT_DS_MIN_MAX_HEAP_HPP
+
+#include <cassert>
+
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Double-ended priority queue, as described by Atkinson et al. in
+  // "Min-Max Heaps and Generalized Priority Queues" (1986). Both the minimum
+  // and the maximum can be accessed in O(1), and removed in O(log n).
+  // Even levels of the tree are min levels, while odd levels are max levels.
+  template <typename T, typename Compare = eastl::less<T>>
+  class MinMaxHeap
+  {
+  public:
+    MinMaxHeap(const Compare& compare = Compare())
+        : elements()
+        , compare(compare) {}
+
+    void push(const T& element)
+    {
+      this->elements.push_back(element);
+      this->bubbleUp(static_cast<int>(this->elements.size()) - 1);
+    }
+
+    const T& getMin() const
+    {
+      assert(!this->elements.empty());
+      return this->elements[0];
+    }
+
+    const T& getMax() const
+    {
+      assert(!this->elements.empty());
+      return this->elements[this->getMaxIndex()];
+    }
+
+    void popMin()
+    {
+      this->removeAt(0);
+    }
+
+    void popMax()
+    {
+      this->removeAt(this->getMaxIndex());
+    }
+
+    void replaceMax(const T& element)
+    {
+      this->popMax();
+      this->push(element);
+    }
+
+    void clear()
+    {
+      this->elements.clear();
+    }
+
+    int size() const
+    {
+      return static_cast<int>(this->elements.size());
+    }
+
+    bool empty() const
+    {
+      return this->elements.empty();
+    }
+
+    // The elements, in heap order.
+    const eastl::vector<T>& getElements() const
+    {
+      return this->elements;
+    }
+  private:
+    static bool isOnMinLevel(int index)
+    {
+      int level = 0;
+      for (int i = index + 1; i > 1; i >>= 1) {
+        level++;
+      }
+
+      return (level % 2) == 0;
+    }
+
+    static int getParentIndex(int index)
+    {
+      return (index - 1) / 2;
+    }
+
+    bool isBefore(int indexA, int indexB, bool isMinOrder) const
+    {
+      return isMinOrder
+             ? this->compare(this->elements[indexA], this->elements[indexB])
+             : this->compare(this->elements[indexB], this->elements[indexA]);
+    }
+
+    int getMaxIndex() const
+    {
+      const int numElements = static_cast<int>(this->elements.size());
+      if (numElements <= 2) {
+        return numElements - 1;
+      }
+
+      return (this->compare(this->elements[1], this->elements[2])) ? 2 : 1;
+    }
+
+    void removeAt(int index)
+    {
+      assert(index >= 0 && index < this->elements.size());
+      this->elements[index] = this->elements.back();
+      this->elements.pop_back();
+      if (index < this->elements.size()) {
+        this->trickleDown(index);
+      }
+    }
+
+    void bubbleUp(int index)
+    {
+      if (index == 0) {
+        return;
+      }
+
+      const int parentIndex = getParentIndex(index);
+      const bool isMinOrder = isOnMinLevel(index);
+      if (this->isBefore(parentIndex, index, isMinOrder)) {
+        // The element belongs to the levels of the other order.
+        eastl::swap(this->elements[index], this->elements[parentIndex]);
+        this->bubbleUpGrandparents(parentIndex, !isMinOrder);
+      } else {
+        this->bubbleUpGrandparents(index, isMinOrder);
+      }
+    }
+
+    void bubbleUpGrandparents(int index, bool isMinOrder)
+    {
+      while (index > 2) {
+        const int grandparentIndex = getParentIndex(getParentIndex(index));
+        if (!this->isBefore(index, grandparentIndex, isMinOrder)) {
+          break;
+        }
+
+        eastl::swap(this->elements[index], this->elements[grandparentIndex]);
+        index = grandparentIndex;
+      }
+    }
+
+    void trickleDown(int index)
+    {
+      const bool isMinOrder = isOnMinLevel(index);
+      const int numElements = static_cast<int>(this->elements.size());
+      while ((2 * index) + 1 < numElements) {
+        // Find the first (in the level order) of the children and
+        // grandchildren.
+        int targetIndex = (2 * index) + 1;
+        bool isGrandchild = false;
+        for (int i = (2 * index) + 1; i <= (2 * index) + 2; i++) {
+          if (i >= numElements) {
+            break;
+          }
+
+          if (this->isBefore(i, targetIndex, isMinOrder)) {
+            targetIndex = i;
+            isGrandchild = false;
+          }
+
+          for (int j = (2 * i) + 1; j <= (2 * i) + 2 && j < numElements; j++) {
+            if (this->isBefore(j, targetIndex, isMinOrder)) {
+              targetIndex = j;
+              isGrandchild = true;
+            }
+          }
+        }
+
+        if (!this->isBefore(targetIndex, index, isMinOrder)) {
+          break;
+        }
+
+        eastl::swap(this->elements[targetIndex], this->elements[index]);
+        if (!isGrandchild) {
+          break;
+        }
+
+        const int parentIndex = getParentIndex(targetIndex);
+        if (this->isBefore(parentIndex, targetIndex, isMinOrder)) {
+          eastl::swap(this->elements[targetIndex], this->elements[parentIndex]);
+        }
+
+        index = targetIndex;
+      }
+    }
+
+    eastl::vector<T> elements;
+    Compare compare;
+  };
+}
+
+#endif
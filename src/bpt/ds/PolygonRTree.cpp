@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cmath>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/PolygonRTree.hpp>
+#include <bpt/geometry.hpp>
+
+namespace bpt
+{
+  PolygonRTree::PolygonRTree()
+      : polygons()
+      , polygonBounds()
+      , nodes()
+      , leafPolygons()
+      , rootIndex(-1) {}
+
+  PolygonRTree::PolygonRTree(const eastl::vector<cx::NPolygon>& polygons)
+      : PolygonRTree()
+  {
+    this->polygons = polygons;
+
+    eastl::vector<Entry> entries;
+    for (int i = 0; i < polygons.size(); i++) {
+      if (polygons[i].vertices.empty()) {
+        this->polygonBounds.push_back(Bounds{ 0.f, 0.f, 0.f, 0.f });
+        continue;
+      }
+
+      Bounds bounds{
+          polygons[i].vertices[0].x,
+          polygons[i].vertices[0].y,
+          polygons[i].vertices[0].x,
+          polygons[i].vertices[0].y
+      };
+      for (const cx::Point& vertex : polygons[i].vertices) {
+        bounds.minX = std::min(bounds.minX, vertex.x);
+        bounds.minY = std::min(bounds.minY, vertex.y);
+        bounds.maxX = std::max(bounds.maxX, vertex.x);
+        bounds.maxY = std::max(bounds.maxY, vertex.y);
+      }
+
+      this->polygonBounds.push_back(bounds);
+      entries.push_back(Entry{ bounds, i });
+    }
+
+    if (entries.empty()) {
+      return;
+    }
+
+    // Pack the leaves, then keep packing each level until only the root
+    // is left. Children of a node are stored contiguously.
+    sortEntriesForPacking(entries);
+    for (const Entry& entry : entries) {
+      this->leafPolygons.push_back(entry.index);
+    }
+
+    eastl::vector<Entry> levelEntries;
+    for (int i = 0; i < entries.size(); i += nodeCapacity) {
+      const int numChildren = std::min(nodeCapacity,
+                                       static_cast<int>(entries.size()) - i);
+      Node node{ entries[i].bounds, i, numChildren, true };
+      for (int j = i + 1; j < i + numChildren; j++) {
+        node.bounds.minX = std::min(node.bounds.minX, entries[j].bounds.minX);
+        node.bounds.minY = std::min(node.bounds.minY, entries[j].bounds.minY);
+        node.bounds.maxX = std::max(node.bounds.maxX, entries[j].bounds.maxX);
+        node.bounds.maxY = std::max(node.bounds.maxY, entries[j].bounds.maxY);
+      }
+
+      levelEntries.push_back(Entry{ node.bounds,
+                                    static_cast<int>(this->nodes.size()) });
+      this->nodes.push_back(node);
+    }
+
+    while (levelEntries.size() > 1) {
+      sortEntriesForPacking(levelEntries);
+
+      // Re-store the level in packing order so that siblings are
+      // contiguous.
+      const int levelStart = static_cast<int>(this->nodes.size());
+      for (const Entry& entry : levelEntries) {
+        const Node node = this->nodes[entry.index];
+        this->nodes.push_back(node);
+      }
+
+      eastl::vector<Entry> parentEntries;
+      for (int i = 0; i < levelEntries.size(); i += nodeCapacity) {
+        const int numChildren = std::min(
+            nodeCapacity, static_cast<int>(levelEntries.size()) - i);
+        Node node{ levelEntries[i].bounds, levelStart + i, numChildren, false };
+        for (int j = i + 1; j < i + numChildren; j++) {
+          const Bounds& bounds = levelEntries[j].bounds;
+          node.bounds.minX = std::min(node.bounds.minX, bounds.minX);
+          node.bounds.minY = std::min(node.bounds.minY, bounds.minY);
+          node.bounds.maxX = std::max(node.bounds.maxX, bounds.maxX);
+          node.bounds.maxY = std::max(node.bounds.maxY, bounds.maxY);
+        }
+
+        parentEntries.push_back(Entry{
+            node.bounds, static_cast<int>(this->nodes.size())
+        });
+        this->nodes.push_back(node);
+      }
+
+      levelEntries = parentEntries;
+    }
+
+    this->rootIndex = levelEntries[0].index;
+  }
+
+  int PolygonRTree::countPolygonsIntersectingFootprint(
+      const Footprint& footprint) const
+  {
+    if (this->rootIndex < 0) {
+      return 0;
+    }
+
+    return this->countIntersectingInNode(this->rootIndex, footprint);
+  }
+
+  int PolygonRTree::getNumPolygons() const
+  {
+    return static_cast<int>(this->polygons.size());
+  }
+
+  const eastl::vector<cx::NPolygon>& PolygonRTree::getPolygons() const
+  {
+    return this->polygons;
+  }
+
+  void PolygonRTree::sortEntriesForPacking(eastl::vector<Entry>& entries)
+  {
+    // Sort-Tile-Recursive: sort by x, cut into vertical slices of
+    // sqrt(number of nodes) nodes each, then sort each slice by y.
+    auto centerX = [](const Entry& entry) {
+      return entry.bounds.minX + entry.bounds.maxX;
+    };
+    auto centerY = [](const Entry& entry) {
+      return entry.bounds.minY + entry.bounds.maxY;
+    };
+
+    std::sort(entries.begin(),
+              entries.end(),
+              [&centerX](const Entry& entryA, const Entry& entryB) {
+                return centerX(entryA) < centerX(entryB);
+              });
+
+    const int numNodes = (static_cast<int>(entries.size()) + nodeCapacity - 1)
+                         / nodeCapacity;
+    const int numSlices = static_cast<int>(
+        std::ceil(std::sqrt(static_cast<float>(numNodes))));
+    const int sliceSize = numSlices * nodeCapacity;
+    for (int i = 0; i < entries.size(); i += sliceSize) {
+      auto sliceEnd = entries.begin()
+                      + std::min(i + sliceSize,
+                                 static_cast<int>(entries.size()));
+      std::sort(entries.begin() + i,
+                sliceEnd,
+                [&centerY](const Entry& entryA, const Entry& entryB) {
+                  return centerY(entryA) < centerY(entryB);
+                });
+    }
+  }
+
+  int PolygonRTree::countIntersectingInNode(int nodeIndex,
+                                            const Footprint& footprint) const
+  {
+    const Node& node = this->nodes[nodeIndex];
+    if (node.bounds.maxX < footprint.minX
+        || node.bounds.minX > footprint.maxX
+        || node.bounds.maxY < footprint.minY
+        || node.bounds.minY > footprint.maxY) {
+      return 0;
+    }
+
+    int numIntersecting = 0;
+    for (int i = node.firstChild; i < node.firstChild + node.numChildren; i++) {
+      if (node.isLeaf) {
+        const int polygonIndex = this->leafPolygons[i];
+        const Bounds& bounds = this->polygonBounds[polygonIndex];
+        if (bounds.maxX < footprint.minX
+            || bounds.minX > footprint.maxX
+            || bounds.maxY < footprint.minY
+            || bounds.minY > footprint.maxY) {
+          continue;
+        }
+
+        if (isFootprintIntersectingNPolygon(footprint,
+                                            this->polygons[polygonIndex])) {
+          numIntersecting++;
+        }
+      } else {
+        numIntersecting += this->countIntersectingInNode(i, footprint);
+      }
+    }
+
+    return numIntersecting;
+  }
+}
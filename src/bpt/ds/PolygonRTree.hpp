@@ -0,0 +1,63 @@
+#ifndef BPT_DS_POLYGON_R_TREE_HPP
+#define BPT_DS_POLYGON_R_TREE_HPP
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+
+namespace bpt
+{
+  // Static R-tree over the AABBs of a set of polygons, bulk-loaded using
+  // Sort-Tile-Recursive (STR) packing. Queries only run the exact
+  // footprint-polygon test on polygons whose AABBs overlap the footprint.
+  class PolygonRTree
+  {
+  public:
+    PolygonRTree();
+    PolygonRTree(const eastl::vector<cx::NPolygon>& polygons);
+
+    int countPolygonsIntersectingFootprint(const Footprint& footprint) const;
+    int getNumPolygons() const;
+    const eastl::vector<cx::NPolygon>& getPolygons() const;
+  private:
+    struct Bounds
+    {
+      float minX;
+      float minY;
+      float maxX;
+      float maxY;
+    };
+
+    struct Node
+    {
+      Bounds bounds;
+      // Children are either nodes or polygon entries, depending on isLeaf.
+      int firstChild;
+      int numChildren;
+      bool isLeaf;
+    };
+
+    struct Entry
+    {
+      Bounds bounds;
+      int index;
+    };
+
+    static constexpr int nodeCapacity = 8;
+
+    static void sortEntriesForPacking(eastl::vector<Entry>& entries);
+    int countIntersectingInNode(int nodeIndex,
+                                const Footprint& footprint) const;
+
+    eastl::vector<cx::NPolygon> polygons;
+    eastl::vector<Bounds> polygonBounds;
+    eastl::vector<Node> nodes;
+    // Polygon indices in leaf order.
+    eastl::vector<int> leafPolygons;
+    int rootIndex;
+  };
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include <cassert>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/FlowMatrix.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+#include <bpt/ds/Problem.hpp>
+
+namespace bpt
+{
+  Problem::Problem(const eastl::vector<InputBuilding>& inputBuildings,
+                   const cx::NPolygon& boundingArea,
+                   const eastl::vector<eastl::vector<float>>& flowRates,
+                   const eastl::vector<cx::NPolygon>& floodProneAreas,
+                   const eastl::vector<cx::NPolygon>& landslideProneAreas,
+                   const float floodProneAreaPenalty,
+                   const float landslideProneAreaPenalty,
+                   const float buildingDistanceWeight)
+      : Problem(inputBuildings,
+                boundingArea,
+                flowRates,
+                floodProneAreas,
+                landslideProneAreas,
+                floodProneAreaPenalty,
+                landslideProneAreaPenalty,
+                buildingDistanceWeight,
+                eastl::vector<float>{}) {}
+
+  Problem::Problem(const eastl::vector<InputBuilding>& inputBuildings,
+                   const cx::NPolygon& boundingArea,
+                   const eastl::vector<eastl::vector<float>>& flowRates,
+                   const eastl::vector<cx::NPolygon>& floodProneAreas,
+                   const eastl::vector<cx::NPolygon>& landslideProneAreas,
+                   const float floodProneAreaPenalty,
+                   const float landslideProneAreaPenalty,
+                   const float buildingDistanceWeight,
+                   const eastl::vector<float>& allowedOrientations)
+      : Problem(inputBuildings,
+                boundingArea,
+                FlowMatrix{ flowRates },
+                floodProneAreas,
+                landslideProneAreas,
+                floodProneAreaPenalty,
+                landslideProneAreaPenalty,
+                buildingDistanceWeight,
+                allowedOrientations) {}
+
+  Problem::Problem(const eastl::vector<InputBuilding>& inputBuildings,
+                   const cx::NPolygon& boundingArea,
+                   const FlowMatrix& flowRates,
+                   const eastl::vector<cx::NPolygon>& floodProneAreas,
+                   const eastl::vector<cx::NPolygon>& landslideProneAreas,
+                   const float floodProneAreaPenalty,
+                   const float landslideProneAreaPenalty,
+                   const float buildingDistanceWeight,
+                   const eastl::vector<float>& allowedOrientations)
+      : inputBuildings(inputBuildings)
+      , boundingArea(boundingArea)
+      , flowRates(flowRates)
+      , floodProneAreas(floodProneAreas)
+      , landslideProneAreas(landslideProneAreas)
+      , floodProneAreaPenalty(floodProneAreaPenalty)
+      , landslideProneAreaPenalty(landslideProneAreaPenalty)
+      , buildingDistanceWeight(buildingDistanceWeight)
+      , footprintTable(inputBuildings, allowedOrientations)
+  {
+    assert(flowRates.getNumBuildings() == inputBuildings.size());
+  }
+}
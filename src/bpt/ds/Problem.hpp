@@ -0,0 +1,65 @@
+#ifndef BPT_DS_PROBLEM_HPP
+#define BPT_DS_PROBLEM_HPP
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/FlowMatrix.hpp>
+#include <bpt/ds/FootprintTable.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+#include <bpt/ds/PolygonRTree.hpp>
+#include <bpt/ds/SiteBoundary.hpp>
+
+namespace bpt
+{
+  // The inputs of a GA run, with the site and hazard areas already
+  // preprocessed. A problem is never modified once built, so a single
+  // instance can be shared by concurrent runs.
+  //
+  // If allowed orientations are given, buildings are only ever placed at
+  // one of them, and their footprints come from a precomputed table.
+  struct Problem
+  {
+    Problem(const eastl::vector<InputBuilding>& inputBuildings,
+            const cx::NPolygon& boundingArea,
+            const eastl::vector<eastl::vector<float>>& flowRates,
+            const eastl::vector<cx::NPolygon>& floodProneAreas,
+            const eastl::vector<cx::NPolygon>& landslideProneAreas,
+            const float floodProneAreaPenalty,
+            const float landslideProneAreaPenalty,
+            const float buildingDistanceWeight);
+    Problem(const eastl::vector<InputBuilding>& inputBuildings,
+            const cx::NPolygon& boundingArea,
+            const eastl::vector<eastl::vector<float>>& flowRates,
+            const eastl::vector<cx::NPolygon>& floodProneAreas,
+            const eastl::vector<cx::NPolygon>& landslideProneAreas,
+            const float floodProneAreaPenalty,
+            const float landslideProneAreaPenalty,
+            const float buildingDistanceWeight,
+            const eastl::vector<float>& allowedOrientations);
+    // Same as above, but with the flow rates already in a flow matrix, e.g.
+    // one mapped from a file. The flow rates are shared, not copied.
+    Problem(const eastl::vector<InputBuilding>& inputBuildings,
+            const cx::NPolygon& boundingArea,
+            const FlowMatrix& flowRates,
+            const eastl::vector<cx::NPolygon>& floodProneAreas,
+            const eastl::vector<cx::NPolygon>& landslideProneAreas,
+            const float floodProneAreaPenalty,
+            const float landslideProneAreaPenalty,
+            const float buildingDistanceWeight,
+            const eastl::vector<float>& allowedOrientations);
+
+    eastl::vector<InputBuilding> inputBuildings;
+    SiteBoundary boundingArea;
+    FlowMatrix flowRates;
+    PolygonRTree floodProneAreas;
+    PolygonRTree landslideProneAreas;
+    float floodProneAreaPenalty;
+    float landslideProneAreaPenalty;
+    float buildingDistanceWeight;
+    FootprintTable footprintTable;
+  };
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BPT_DS_PROBLEM_CHANGE_HPP
+#define BPT_DS_PROBLEM_CHANGE_HPP
+
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Describes how a problem was edited into a new one, for re-optimizing
+  // (see GA::reoptimizeSolutions()). The buildings of the new problem are
+  // the remaining buildings of the previous one, in the same order, followed
+  // by the added buildings. Flow rate changes need no description, since
+  // they are found by comparing the flow rates of both problems.
+  struct ProblemChange
+  {
+    // Indices of the buildings of the previous problem that were removed.
+    eastl::vector<int> removedBuildings;
+    int numAddedBuildings;
+    // Whether the flood-prone or landslide-prone areas were edited.
+    bool areHazardAreasChanged;
+    // Whether the site boundary was edited. If not, remapped solutions whose
+    // buildings did not move are not checked for feasibility again.
+    bool isSiteChanged;
+  };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef BPT_DS_PROBLEM_INSTANCE_HPP
+#define BPT_DS_PROBLEM_INSTANCE_HPP
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/FlowMatrix.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+#include <bpt/GAParameters.hpp>
+
+namespace bpt
+{
+  // The raw inputs of a GA run, together with the parameters to run it
+  // with, as stored in problem instance files (see bpt/io.hpp). No
+  // orientations allowed means that buildings can be placed at any one.
+  //
+  // If a flow matrix file path is set, the instance file only refers to
+  // that file, rather than holding the flow rates itself. A relative path
+  // is relative to the directory of the instance file.
+  struct ProblemInstance
+  {
+    eastl::vector<InputBuilding> inputBuildings;
+    cx::NPolygon boundingArea;
+    FlowMatrix flowRates;
+    eastl::string flowMatrixFilePath;
+    eastl::vector<cx::NPolygon> floodProneAreas;
+    eastl::vector<cx::NPolygon> landslideProneAreas;
+    float floodProneAreaPenalty;
+    float landslideProneAreaPenalty;
+    float buildingDistanceWeight;
+    eastl::vector<float> allowedOrientations;
+    GAParameters parameters;
+  };
+}
+
+#endif
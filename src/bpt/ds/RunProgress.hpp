@@ -0,0 +1,33 @@
+#ifndef BPT_DS_RUN_PROGRESS_HPP
+#define BPT_DS_RUN_PROGRESS_HPP
+
+#include <cstdint>
+
+#include <bpt/ds/Solution.hpp>
+
+namespace bpt
+{
+  // Snapshot of the progress of a GA run, taken while it goes on (see
+  // bpt/RunProgressBoard.hpp).
+  struct RunProgress
+  {
+    bool isRunning;
+    // Number of generations done, with 0 being the initial population, so
+    // that the fitnesses are those at this index of the recent run
+    // statistics. -1 until the initial population is done.
+    int generationNumber;
+    // NaN in multi-objective runs, which have no fitness.
+    float bestFitness;
+    float averageFitness;
+    float worstFitness;
+    // Fitnesses (or objectives) computed so far, including those found in
+    // the fitness cache.
+    uint64_t numEvaluations;
+    uint64_t numCachedEvaluations;
+    // Has no buildings while the run has no best solution yet, and in
+    // multi-objective runs. Its genes are always stored as floats.
+    Solution bestSolution;
+  };
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef BPT_DS_RUN_RESULT_HPP
+#define BPT_DS_RUN_RESULT_HPP
+
+#include <EASTL/vector.h>
+
+#include <bpt/ds/Solution.hpp>
+#include <bpt/GAParameters.hpp>
+
+namespace bpt
+{
+  // Output and statistics of a single GA run, as returned by batch runs.
+  struct RunResult
+  {
+    GAParameters parameters;
+    eastl::vector<eastl::vector<Solution>> solutions;
+    eastl::vector<float> averageFitnesses;
+    eastl::vector<float> bestFitnesses;
+    eastl::vector<float> worstFitnesses;
+    eastl::vector<float> fitnessCacheHitRates;
+  };
+}
+
+#endif
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cmath>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/SiteBoundary.hpp>
+#include <bpt/geometry.hpp>
+
+namespace bpt
+{
+  SiteBoundary::SiteBoundary()
+      : polygon()
+      , minX(0.f)
+      , minY(0.f)
+      , maxX(0.f)
+      , maxY(0.f)
+      , cellWidth(1.f)
+      , cellHeight(1.f)
+      , numColumns(1)
+      , numRows(1)
+      , cellEdgeOffsets(2, 0)
+      , cellEdges()
+      , rowEdgeOffsets(2, 0)
+      , rowEdges() {}
+
+  SiteBoundary::SiteBoundary(const cx::NPolygon& polygon)
+      : SiteBoundary()
+  {
+    this->polygon = polygon;
+
+    const int numVertices = static_cast<int>(polygon.vertices.size());
+    if (numVertices == 0) {
+      return;
+    }
+
+    this->minX = polygon.vertices[0].x;
+    this->maxX = polygon.vertices[0].x;
+    this->minY = polygon.vertices[0].y;
+    this->maxY = polygon.vertices[0].y;
+    for (const cx::Point& vertex : polygon.vertices) {
+      this->minX = std::min(this->minX, vertex.x);
+      this->maxX = std::max(this->maxX, vertex.x);
+      this->minY = std::min(this->minY, vertex.y);
+      this->maxY = std::max(this->maxY, vertex.y);
+    }
+
+    // Aim for roughly one edge per cell along the boundary.
+    constexpr int maxGridSize = 1024;
+    const int gridSize = std::clamp(
+        static_cast<int>(std::ceil(std::sqrt(static_cast<float>(numVertices)))),
+        1,
+        maxGridSize);
+    this->numColumns = gridSize;
+    this->numRows = gridSize;
+    this->cellWidth = std::max((this->maxX - this->minX) / this->numColumns,
+                               1e-6f);
+    this->cellHeight = std::max((this->maxY - this->minY) / this->numRows,
+                                1e-6f);
+
+    // Two passes over the edges. The first counts the edges per bucket, and
+    // the second fills the buckets in.
+    const int numCells = this->numColumns * this->numRows;
+    this->cellEdgeOffsets.assign(numCells + 1, 0);
+    this->rowEdgeOffsets.assign(this->numRows + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+      eastl::vector<int> cellCursors;
+      eastl::vector<int> rowCursors;
+      if (pass == 1) {
+        for (int i = 0; i < numCells; i++) {
+          this->cellEdgeOffsets[i + 1] += this->cellEdgeOffsets[i];
+        }
+
+        for (int i = 0; i < this->numRows; i++) {
+          this->rowEdgeOffsets[i + 1] += this->rowEdgeOffsets[i];
+        }
+
+        this->cellEdges.resize(this->cellEdgeOffsets[numCells]);
+        this->rowEdges.resize(this->rowEdgeOffsets[this->numRows]);
+        cellCursors.assign(this->cellEdgeOffsets.begin(),
+                           this->cellEdgeOffsets.end() - 1);
+        rowCursors.assign(this->rowEdgeOffsets.begin(),
+                          this->rowEdgeOffsets.end() - 1);
+      }
+
+      for (int i = 0; i < numVertices; i++) {
+        const cx::Point& start = polygon.vertices[i];
+        const cx::Point& end = polygon.vertices[(i + 1) % numVertices];
+        const int startColumn = this->getColumnIndex(std::min(start.x, end.x));
+        const int endColumn = this->getColumnIndex(std::max(start.x, end.x));
+        const int startRow = this->getRowIndex(std::min(start.y, end.y));
+        const int endRow = this->getRowIndex(std::max(start.y, end.y));
+        for (int row = startRow; row <= endRow; row++) {
+          if (pass == 0) {
+            this->rowEdgeOffsets[row + 1]++;
+          } else {
+            this->rowEdges[rowCursors[row]++] = i;
+          }
+
+          for (int column = startColumn; column <= endColumn; column++) {
+            const int cellIndex = (row * this->numColumns) + column;
+            if (pass == 0) {
+              this->cellEdgeOffsets[cellIndex + 1]++;
+            } else {
+              this->cellEdges[cellCursors[cellIndex]++] = i;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  bool SiteBoundary::isFootprintWithin(const Footprint& footprint) const
+  {
+    if (this->polygon.vertices.empty()) {
+      return false;
+    }
+
+    for (const cx::Point& corner : footprint.corners) {
+      if (!this->isPointWithin(corner)) {
+        return false;
+      }
+    }
+
+    // Only the edges that share a cell with the footprint AABB can cut into
+    // the footprint. An edge may be checked more than once if it spans
+    // multiple cells, but that does not change the result.
+    const int numVertices = static_cast<int>(this->polygon.vertices.size());
+    const int startColumn = this->getColumnIndex(footprint.minX);
+    const int endColumn = this->getColumnIndex(footprint.maxX);
+    const int startRow = this->getRowIndex(footprint.minY);
+    const int endRow = this->getRowIndex(footprint.maxY);
+    for (int row = startRow; row <= endRow; row++) {
+      for (int column = startColumn; column <= endColumn; column++) {
+        const int cellIndex = (row * this->numColumns) + column;
+        for (int k = this->cellEdgeOffsets[cellIndex];
+             k < this->cellEdgeOffsets[cellIndex + 1];
+             k++) {
+          const int edgeIndex = this->cellEdges[k];
+          const cx::Point& start = this->polygon.vertices[edgeIndex];
+          const cx::Point& end = this->polygon.vertices[(edgeIndex + 1)
+                                                        % numVertices];
+          if (isSegmentIntersectingFootprint(start, end, footprint)) {
+            return false;
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool SiteBoundary::isPointWithin(const cx::Point& point) const
+  {
+    // Points outside the vertical extent of the polygon cannot have edges
+    // crossing their rays. The row lookup clamps, so bail out early.
+    if (point.y < this->minY || point.y > this->maxY) {
+      return false;
+    }
+
+    // Same crossing number test as bpt::isPointWithinNPolygon(). Every edge
+    // whose y-range contains the point is in the point's row, and edges are
+    // listed only once per row, so the parity is the same.
+    const int numVertices = static_cast<int>(this->polygon.vertices.size());
+    const int row = this->getRowIndex(point.y);
+    bool isInside = false;
+    for (int k = this->rowEdgeOffsets[row];
+         k < this->rowEdgeOffsets[row + 1];
+         k++) {
+      const int edgeIndex = this->rowEdges[k];
+      if (isEdgeCrossingRightRay(
+              this->polygon.vertices[(edgeIndex + 1) % numVertices],
+              this->polygon.vertices[edgeIndex],
+              point)) {
+        isInside = !isInside;
+      }
+    }
+
+    return isInside;
+  }
+
+  const cx::NPolygon& SiteBoundary::getPolygon() const
+  {
+    return this->polygon;
+  }
+
+  float SiteBoundary::getMinX() const
+  {
+    return this->minX;
+  }
+
+  float SiteBoundary::getMinY() const
+  {
+    return this->minY;
+  }
+
+  float SiteBoundary::getMaxX() const
+  {
+    return this->maxX;
+  }
+
+  float SiteBoundary::getMaxY() const
+  {
+    return this->maxY;
+  }
+
+  int SiteBoundary::getColumnIndex(float x) const
+  {
+    const int column = static_cast<int>(std::floor((x - this->minX)
+                                                   / this->cellWidth));
+    return std::clamp(column, 0, this->numColumns - 1);
+  }
+
+  int SiteBoundary::getRowIndex(float y) const
+  {
+    const int row = static_cast<int>(std::floor((y - this->minY)
+                                                / this->cellHeight));
+    return std::clamp(row, 0, this->numRows - 1);
+  }
+}
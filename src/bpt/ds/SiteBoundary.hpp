@@ -0,0 +1,54 @@
+#ifndef BPT_DS_SITE_BOUNDARY_HPP
+#define BPT_DS_SITE_BOUNDARY_HPP
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+
+namespace bpt
+{
+  // Preprocessed site boundary for fast containment tests. The polygon edges
+  // are bucketed into a uniform grid over the polygon AABB, so a query only
+  // needs to look at the edges near the footprint. Point-in-polygon tests
+  // use per-row edge lists so that the crossing number only considers edges
+  // that can cross the ray. Results are identical to
+  // bpt::isFootprintWithinNPolygon().
+  class SiteBoundary
+  {
+  public:
+    SiteBoundary();
+    SiteBoundary(const cx::NPolygon& polygon);
+
+    bool isFootprintWithin(const Footprint& footprint) const;
+    bool isPointWithin(const cx::Point& point) const;
+    const cx::NPolygon& getPolygon() const;
+    float getMinX() const;
+    float getMinY() const;
+    float getMaxX() const;
+    float getMaxY() const;
+  private:
+    int getColumnIndex(float x) const;
+    int getRowIndex(float y) const;
+
+    cx::NPolygon polygon;
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    float cellWidth;
+    float cellHeight;
+    int numColumns;
+    int numRows;
+    // Edge lists are stored in a compressed form. The edges of cell i are
+    // cellEdges[cellEdgeOffsets[i]] to cellEdges[cellEdgeOffsets[i + 1] - 1].
+    // An edge is identified by the index of its starting vertex.
+    eastl::vector<int> cellEdgeOffsets;
+    eastl::vector<int> cellEdges;
+    eastl::vector<int> rowEdgeOffsets;
+    eastl::vector<int> rowEdges;
+  };
+}
+
+#endif
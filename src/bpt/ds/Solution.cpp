@@ -1,38 +1,124 @@
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <EASTL/unique_ptr.h>
 
 #include <corex/math.hpp>
 
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/FootprintTable.hpp>
+#include <bpt/ds/InputBuilding.hpp>
 #include <bpt/ds/Solution.hpp>
 
 namespace bpt
 {
+  static_assert(std::is_trivially_copyable<GeneQuantizer>::value
+                && sizeof(GeneQuantizer) % sizeof(uint16_t) == 0,
+                "Quantizers are stored as gene words.");
+
   Solution::Solution()
       : genes()
       , numBuildings(0)
+      , isEncodingCompact(false)
+      , hasFitnessSet(false)
       , fitness(0)
-      , hasFitnessSet(false) {}
+      , footprintCache() {}
 
   Solution::Solution(int numBuildings)
-      : genes(numBuildings * 3, 0.f)
+      : genes(numBuildings * 3 * 2, 0)
+      , numBuildings(numBuildings)
+      , isEncodingCompact(false)
+      , hasFitnessSet(false)
+      , fitness(0)
+      , footprintCache() {}
+
+  Solution::Solution(int numBuildings, const GeneQuantizer& quantizer)
+      : genes(numQuantizerWords + (numBuildings * 3), 0)
       , numBuildings(numBuildings)
+      , isEncodingCompact(true)
+      , hasFitnessSet(false)
       , fitness(0)
-      , hasFitnessSet(false) {}
+      , footprintCache()
+  {
+    std::memcpy(this->genes.data(), &quantizer, sizeof(quantizer));
+  }
+
+  Solution::Solution(const Solution& other)
+      : genes(other.genes)
+      , numBuildings(other.numBuildings)
+      , isEncodingCompact(other.isEncodingCompact)
+      , hasFitnessSet(other.hasFitnessSet)
+      , fitness(other.fitness)
+      , footprintCache(other.footprintCache
+                       ? eastl::make_unique<FootprintCache>(
+                           *other.footprintCache)
+                       : nullptr) {}
+
+  Solution::Solution(Solution&& other) = default;
+
+  Solution::~Solution() = default;
+
+  Solution& Solution::operator=(const Solution& other)
+  {
+    if (this != &other) {
+      this->genes = other.genes;
+      this->numBuildings = other.numBuildings;
+      this->isEncodingCompact = other.isEncodingCompact;
+      this->hasFitnessSet = other.hasFitnessSet;
+      this->fitness = other.fitness;
+
+      if (!other.footprintCache) {
+        this->footprintCache.reset();
+      } else if (this->footprintCache) {
+        *this->footprintCache = *other.footprintCache;
+      } else {
+        this->footprintCache = eastl::make_unique<FootprintCache>(
+            *other.footprintCache);
+      }
+    }
+
+    return *this;
+  }
 
-  Solution::Solution(const Solution& other) = default;
+  Solution& Solution::operator=(Solution&& other) = default;
 
   void Solution::setBuildingXPos(int buildingIndex, float xPos)
   {
-    this->genes[(buildingIndex * 3)] = xPos;
+    if (this->isEncodingCompact) {
+      this->genes[numQuantizerWords + (buildingIndex * 3)] =
+          this->getQuantizer().encodeXPos(xPos);
+    } else {
+      this->setFullGene(buildingIndex * 3, xPos);
+    }
+
+    this->invalidateBuildingFootprint(buildingIndex);
   }
 
   void Solution::setBuildingYPos(int buildingIndex, float yPos)
   {
-    this->genes[(buildingIndex * 3) + 1] = yPos;
+    if (this->isEncodingCompact) {
+      this->genes[numQuantizerWords + (buildingIndex * 3) + 1] =
+          this->getQuantizer().encodeYPos(yPos);
+    } else {
+      this->setFullGene((buildingIndex * 3) + 1, yPos);
+    }
+
+    this->invalidateBuildingFootprint(buildingIndex);
   }
 
   void Solution::setBuildingRotation(int buildingIndex, float rotation)
   {
-    this->genes[(buildingIndex * 3) + 2] = rotation;
+    if (this->isEncodingCompact) {
+      this->genes[numQuantizerWords + (buildingIndex * 3) + 2] =
+          this->getQuantizer().encodeRotation(rotation);
+    } else {
+      this->setFullGene((buildingIndex * 3) + 2, rotation);
+    }
+
+    this->invalidateBuildingFootprint(buildingIndex);
   }
 
   void Solution::setFitness(double fitness)
@@ -43,17 +129,32 @@ namespace bpt
 
   float Solution::getBuildingXPos(int buildingIndex) const
   {
-    return this->genes[(buildingIndex * 3)];
+    if (this->isEncodingCompact) {
+      return this->getQuantizer().decodeXPos(
+          this->genes[numQuantizerWords + (buildingIndex * 3)]);
+    }
+
+    return this->getFullGene(buildingIndex * 3);
   }
 
   float Solution::getBuildingYPos(int buildingIndex) const
   {
-    return this->genes[(buildingIndex * 3) + 1];
+    if (this->isEncodingCompact) {
+      return this->getQuantizer().decodeYPos(
+          this->genes[numQuantizerWords + (buildingIndex * 3) + 1]);
+    }
+
+    return this->getFullGene((buildingIndex * 3) + 1);
   }
 
   float Solution::getBuildingRotation(int buildingIndex) const
   {
-    return this->genes[(buildingIndex * 3) + 2];
+    if (this->isEncodingCompact) {
+      return this->getQuantizer().decodeRotation(
+          this->genes[numQuantizerWords + (buildingIndex * 3) + 2]);
+    }
+
+    return this->getFullGene((buildingIndex * 3) + 2);
   }
 
   int Solution::getNumBuildings() const
@@ -67,19 +168,119 @@ namespace bpt
     return this->fitness;
   }
 
+  bool Solution::isCompact() const
+  {
+    return this->isEncodingCompact;
+  }
+
+  const Footprint& Solution::getBuildingFootprint(
+      int buildingIndex,
+      const InputBuilding& inputBuilding) const
+  {
+    this->setFootprintSource(0);
+    FootprintCache& cache = *this->footprintCache;
+    if (!this->isBuildingFootprintCached(buildingIndex)) {
+      cache.footprints[buildingIndex] = computeBuildingFootprint(
+          this->getBuildingXPos(buildingIndex),
+          this->getBuildingYPos(buildingIndex),
+          this->getBuildingRotation(buildingIndex),
+          inputBuilding);
+      cache.isFootprintValid[buildingIndex] = true;
+    }
+
+    return cache.footprints[buildingIndex];
+  }
+
+  const Footprint& Solution::getBuildingFootprint(
+      int buildingIndex,
+      const FootprintTable& footprintTable) const
+  {
+    this->setFootprintSource(footprintTable.getId());
+    FootprintCache& cache = *this->footprintCache;
+    if (!this->isBuildingFootprintCached(buildingIndex)) {
+      cache.footprints[buildingIndex] = footprintTable.getFootprint(
+          buildingIndex,
+          this->getBuildingXPos(buildingIndex),
+          this->getBuildingYPos(buildingIndex),
+          this->getBuildingRotation(buildingIndex));
+      cache.isFootprintValid[buildingIndex] = true;
+    }
+
+    return cache.footprints[buildingIndex];
+  }
+
+  void Solution::clearFootprintCache()
+  {
+    this->footprintCache.reset();
+  }
+
+  float Solution::getFullGene(int geneIndex) const
+  {
+    float gene;
+    std::memcpy(&gene, this->genes.data() + (geneIndex * 2), sizeof(gene));
+    return gene;
+  }
+
+  void Solution::setFullGene(int geneIndex, float gene)
+  {
+    std::memcpy(this->genes.data() + (geneIndex * 2), &gene, sizeof(gene));
+  }
+
+  GeneQuantizer Solution::getQuantizer() const
+  {
+    GeneQuantizer quantizer;
+    std::memcpy(static_cast<void*>(&quantizer),
+                this->genes.data(),
+                sizeof(quantizer));
+    return quantizer;
+  }
+
+  bool Solution::isBuildingFootprintCached(int buildingIndex) const
+  {
+    return this->footprintCache->isFootprintValid[buildingIndex];
+  }
+
+  void Solution::setFootprintSource(uint64_t footprintSourceId) const
+  {
+    if (!this->footprintCache) {
+      this->footprintCache = eastl::make_unique<FootprintCache>();
+      this->footprintCache->footprints.resize(this->numBuildings);
+      this->footprintCache->isFootprintValid.resize(this->numBuildings,
+                                                    false);
+      this->footprintCache->sourceId = footprintSourceId;
+    } else if (footprintSourceId != this->footprintCache->sourceId) {
+      std::fill(this->footprintCache->isFootprintValid.begin(),
+                this->footprintCache->isFootprintValid.end(),
+                false);
+      this->footprintCache->sourceId = footprintSourceId;
+    }
+  }
+
+  void Solution::invalidateBuildingFootprint(int buildingIndex)
+  {
+    if (this->footprintCache) {
+      this->footprintCache->isFootprintValid[buildingIndex] = false;
+    }
+  }
+
   bool Solution::operator==(const Solution& other)
   {
-    if (this->genes.size() == other.genes.size()) {
-      for (int i = 0; i < this->genes.size(); i++) {
-        if (!corex::core::floatEquals(this->genes[i], other.genes[i])) {
-          return false;
-        }
-      }
+    if (this->numBuildings != other.numBuildings) {
+      return false;
+    }
 
-      return true;
+    for (int i = 0; i < this->numBuildings; i++) {
+      if (!corex::core::floatEquals(this->getBuildingXPos(i),
+                                    other.getBuildingXPos(i))
+          || !corex::core::floatEquals(this->getBuildingYPos(i),
+                                       other.getBuildingYPos(i))
+          || !corex::core::floatEquals(this->getBuildingRotation(i),
+                                       other.getBuildingRotation(i))) {
+        return false;
+      }
     }
 
-    return false;
+    return true;
   }
 
   bool Solution::operator!=(const Solution& other)
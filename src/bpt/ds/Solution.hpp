@@ -1,20 +1,39 @@
 #ifndef BPT_DS_SOLUTION_HPP
 #define BPT_DS_SOLUTION_HPP
 
+#include <cstdint>
 #include <cstdlib>
 
+#include <EASTL/unique_ptr.h>
 #include <EASTL/vector.h>
 
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/ds/FootprintTable.hpp>
+#include <bpt/ds/GeneQuantizer.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+
 namespace bpt
 {
   class Solution
   {
     // Solution representation:
     //   [ xPos of building 0, yPos of building 0, rotation of building 0, ... ]
+    //
+    // The genes are either stored as floats, or, in a compact solution, as
+    // 16-bit codes of the given quantizer. Compact solutions decode their
+    // genes on access, and quantize any gene that is set. Either way, the
+    // genes take a single allocation holding only what the encoding needs,
+    // and the quantizer of a compact solution is kept in it too.
   public:
     Solution();
     Solution(const Solution& other);
+    Solution(Solution&& other);
     Solution(int numBuildings);
+    Solution(int numBuildings, const GeneQuantizer& quantizer);
+    ~Solution();
+
+    Solution& operator=(const Solution& other);
+    Solution& operator=(Solution&& other);
 
     void setBuildingXPos(int buildingIndex, float xPos);
     void setBuildingYPos(int buildingIndex, float yPos);
@@ -25,14 +44,59 @@ namespace bpt
     float getBuildingRotation(int buildingIndex) const;
     int getNumBuildings() const;
     double getFitness() const;
+    bool isCompact() const;
+
+    // Footprints are computed lazily and cached until the genes of the
+    // building change. The cache takes several times the memory of the
+    // genes, and is only allocated once a footprint is queried. The input
+    // building must be the same one every time a given building index is
+    // queried.
+    const Footprint& getBuildingFootprint(
+      int buildingIndex,
+      const InputBuilding& inputBuilding) const;
+    // Same as above, but the footprint comes from the table. The cache is
+    // tied to the table it was filled from, and starts over when another
+    // table is used, e.g. when the same solution is scored against several
+    // problems.
+    const Footprint& getBuildingFootprint(
+      int buildingIndex,
+      const FootprintTable& footprintTable) const;
+    void clearFootprintCache();
 
     bool operator==(const Solution& other);
     bool operator!=(const Solution& other);
   private:
-    eastl::vector<float> genes;
+    struct FootprintCache
+    {
+      eastl::vector<Footprint> footprints;
+      eastl::vector<bool> isFootprintValid;
+      // Id of the footprint table the footprints came from, or zero for
+      // input buildings.
+      uint64_t sourceId;
+    };
+
+    // The genes are stored as 16-bit words. A float gene takes two words,
+    // and a compact solution starts with the words of its quantizer.
+    static constexpr int numQuantizerWords = sizeof(GeneQuantizer)
+                                             / sizeof(uint16_t);
+
+    float getFullGene(int geneIndex) const;
+    void setFullGene(int geneIndex, float gene);
+    GeneQuantizer getQuantizer() const;
+    // Fills the cache if there is none, and returns whether the footprint
+    // of the building is in it.
+    bool isBuildingFootprintCached(int buildingIndex) const;
+    // Drops the cached footprints if they came from another source, given
+    // as a footprint table id, or zero for input buildings.
+    void setFootprintSource(uint64_t footprintSourceId) const;
+    void invalidateBuildingFootprint(int buildingIndex);
+
+    eastl::vector<uint16_t> genes;
     int numBuildings;
-    double fitness;
+    bool isEncodingCompact;
     bool hasFitnessSet;
+    double fitness;
+    mutable eastl::unique_ptr<FootprintCache> footprintCache;
   };
 }
 
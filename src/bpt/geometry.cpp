@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cmath>
+
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+#include <bpt/geometry.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    float dot(const cx::Vec2& a, const cx::Vec2& b)
+    {
+      return (a.x * b.x) + (a.y * b.y);
+    }
+
+    float cross(const cx::Vec2& a, const cx::Vec2& b)
+    {
+      return (a.x * b.y) - (a.y * b.x);
+    }
+
+    // Clips a polygon to the inner side of an edge of a footprint, with
+    // Sutherland-Hodgman. The winding is 1 for counter-clockwise footprints,
+    // and -1 for clockwise ones.
+    void clipPolygonByEdge(const eastl::vector<cx::Point>& vertices,
+                           const cx::Point& edgeStart,
+                           const cx::Point& edgeEnd,
+                           const float winding,
+                           eastl::vector<cx::Point>& clippedVertices)
+    {
+      clippedVertices.clear();
+
+      const cx::Vec2 edge = edgeEnd - edgeStart;
+      const int numVertices = static_cast<int>(vertices.size());
+      for (int i = 0; i < numVertices; i++) {
+        const cx::Point& current = vertices[i];
+        const cx::Point& next = vertices[(i + 1) % numVertices];
+        const float currentDistance = winding * cross(edge,
+                                                      current - edgeStart);
+        const float nextDistance = winding * cross(edge, next - edgeStart);
+        if (currentDistance >= 0.f) {
+          clippedVertices.push_back(current);
+        }
+
+        if ((currentDistance >= 0.f) != (nextDistance >= 0.f)) {
+          const float t = currentDistance / (currentDistance - nextDistance);
+          clippedVertices.push_back(cx::Point{
+            current.x + (t * (next.x - current.x)),
+            current.y + (t * (next.y - current.y))
+          });
+        }
+      }
+    }
+
+    float computePolygonArea(const eastl::vector<cx::Point>& vertices)
+    {
+      float doubleArea = 0.f;
+      const int numVertices = static_cast<int>(vertices.size());
+      for (int i = 0; i < numVertices; i++) {
+        const cx::Point& current = vertices[i];
+        const cx::Point& next = vertices[(i + 1) % numVertices];
+        doubleArea += (current.x * next.y) - (next.x * current.y);
+      }
+
+      return std::abs(doubleArea) / 2.f;
+    }
+
+    // Area of the part of a polygon that is inside a footprint. Since a
+    // footprint is convex, the polygon itself may be concave.
+    float computeAreaWithinFootprint(const eastl::vector<cx::Point>& vertices,
+                                     const Footprint& footprint)
+    {
+      const auto& corners = footprint.corners;
+      const float winding = (cross(corners[1] - corners[0],
+                                   corners[2] - corners[1]) >= 0.f)
+                            ? 1.f
+                            : -1.f;
+
+      eastl::vector<cx::Point> clippedVertices = vertices;
+      eastl::vector<cx::Point> nextClippedVertices;
+      for (int i = 0; i < 4 && !clippedVertices.empty(); i++) {
+        clipPolygonByEdge(clippedVertices,
+                          corners[i],
+                          corners[(i + 1) % 4],
+                          winding,
+                          nextClippedVertices);
+        clippedVertices.swap(nextClippedVertices);
+      }
+
+      return computePolygonArea(clippedVertices);
+    }
+
+    // Half of the length of the projection of a footprint onto an axis.
+    float projectFootprint(const Footprint& footprint, const cx::Vec2& axis)
+    {
+      return (footprint.halfExtents[0]
+              * std::abs(dot(footprint.axes[0], axis)))
+             + (footprint.halfExtents[1]
+                * std::abs(dot(footprint.axes[1], axis)));
+    }
+  }
+
+  bool areFootprintsIntersecting(const Footprint& footprintA,
+                                 const Footprint& footprintB)
+  {
+    const cx::Vec2 centerDelta = footprintB.center - footprintA.center;
+
+    // Cheap rejection using the bounding circles first.
+    const float radiusSum = footprintA.radius + footprintB.radius;
+    if (dot(centerDelta, centerDelta) >= radiusSum * radiusSum) {
+      return false;
+    }
+
+    if (footprintA.maxX <= footprintB.minX
+        || footprintB.maxX <= footprintA.minX
+        || footprintA.maxY <= footprintB.minY
+        || footprintB.maxY <= footprintA.minY) {
+      return false;
+    }
+
+    // Separating axis test. Rectangles only have two unique axes each.
+    const eastl::array<const Footprint*, 2> footprints{ &footprintA,
+                                                        &footprintB };
+    for (const Footprint* footprint : footprints) {
+      for (const cx::Vec2& axis : footprint->axes) {
+        const float distance = std::abs(dot(centerDelta, axis));
+        if (distance >= projectFootprint(footprintA, axis)
+                        + projectFootprint(footprintB, axis)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  float computeFootprintOverlapArea(const Footprint& footprintA,
+                                    const Footprint& footprintB)
+  {
+    if (!areFootprintsIntersecting(footprintA, footprintB)) {
+      return 0.f;
+    }
+
+    const eastl::vector<cx::Point> cornersA(footprintA.corners.begin(),
+                                            footprintA.corners.end());
+    return computeAreaWithinFootprint(cornersA, footprintB);
+  }
+
+  float computeFootprintAreaOutsideNPolygon(const Footprint& footprint,
+                                            const cx::NPolygon& polygon)
+  {
+    const float footprintArea = 4.f
+                                * footprint.halfExtents[0]
+                                * footprint.halfExtents[1];
+    return std::max(0.f,
+                    footprintArea - computeAreaWithinFootprint(
+                                      polygon.vertices, footprint));
+  }
+
+  bool isFootprintWithinNPolygon(const Footprint& footprint,
+                                 const cx::NPolygon& polygon)
+  {
+    for (const cx::Point& corner : footprint.corners) {
+      if (!isPointWithinNPolygon(corner, polygon)) {
+        return false;
+      }
+    }
+
+    // All corners are inside, but a concave polygon may still cut into the
+    // footprint through one of its edges.
+    const int numVertices = static_cast<int>(polygon.vertices.size());
+    for (int i = 0; i < numVertices; i++) {
+      const cx::Point& start = polygon.vertices[i];
+      const cx::Point& end = polygon.vertices[(i + 1) % numVertices];
+      if (isSegmentIntersectingFootprint(start, end, footprint)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool isFootprintIntersectingNPolygon(const Footprint& footprint,
+                                       const cx::NPolygon& polygon)
+  {
+    const int numVertices = static_cast<int>(polygon.vertices.size());
+    for (int i = 0; i < numVertices; i++) {
+      const cx::Point& start = polygon.vertices[i];
+      const cx::Point& end = polygon.vertices[(i + 1) % numVertices];
+      if (isSegmentIntersectingFootprint(start, end, footprint)) {
+        return true;
+      }
+    }
+
+    // No polygon edge touches the footprint, so either one contains the
+    // other or they are disjoint.
+    return numVertices > 0
+           && isPointWithinNPolygon(footprint.center, polygon);
+  }
+
+  bool isPointWithinFootprint(const cx::Point& point,
+                              const Footprint& footprint)
+  {
+    const cx::Vec2 delta = point - footprint.center;
+    return std::abs(dot(delta, footprint.axes[0])) < footprint.halfExtents[0]
+           && std::abs(dot(delta, footprint.axes[1]))
+              < footprint.halfExtents[1];
+  }
+
+  bool isPointWithinNPolygon(const cx::Point& point,
+                             const cx::NPolygon& polygon)
+  {
+    // Crossing number test.
+    bool isInside = false;
+    const int numVertices = static_cast<int>(polygon.vertices.size());
+    for (int i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      if (isEdgeCrossingRightRay(polygon.vertices[i],
+                                 polygon.vertices[j],
+                                 point)) {
+        isInside = !isInside;
+      }
+    }
+
+    return isInside;
+  }
+
+  bool isEdgeCrossingRightRay(const cx::Point& edgeStart,
+                              const cx::Point& edgeEnd,
+                              const cx::Point& rayOrigin)
+  {
+    // Checks if the edge crosses the horizontal ray going to the right of the
+    // ray origin.
+    if ((edgeStart.y > rayOrigin.y) == (edgeEnd.y > rayOrigin.y)) {
+      return false;
+    }
+
+    const float intersectX = edgeStart.x
+                             + ((rayOrigin.y - edgeStart.y)
+                                * (edgeEnd.x - edgeStart.x)
+                                / (edgeEnd.y - edgeStart.y));
+    return rayOrigin.x < intersectX;
+  }
+
+  bool areSegmentsCrossing(const cx::Point& startA,
+                           const cx::Point& endA,
+                           const cx::Point& startB,
+                           const cx::Point& endB)
+  {
+    // Only proper crossings count. Segments that merely touch do not.
+    const cx::Vec2 dirA = endA - startA;
+    const cx::Vec2 dirB = endB - startB;
+    const float d0 = cross(dirA, startB - startA);
+    const float d1 = cross(dirA, endB - startA);
+    const float d2 = cross(dirB, startA - startB);
+    const float d3 = cross(dirB, endA - startB);
+    return ((d0 > 0.f && d1 < 0.f) || (d0 < 0.f && d1 > 0.f))
+           && ((d2 > 0.f && d3 < 0.f) || (d2 < 0.f && d3 > 0.f));
+  }
+
+  bool isSegmentIntersectingFootprint(const cx::Point& start,
+                                      const cx::Point& end,
+                                      const Footprint& footprint)
+  {
+    if (std::max(start.x, end.x) <= footprint.minX
+        || std::min(start.x, end.x) >= footprint.maxX
+        || std::max(start.y, end.y) <= footprint.minY
+        || std::min(start.y, end.y) >= footprint.maxY) {
+      return false;
+    }
+
+    if (isPointWithinFootprint(start, footprint)
+        || isPointWithinFootprint(end, footprint)) {
+      return true;
+    }
+
+    for (int i = 0; i < 4; i++) {
+      if (areSegmentsCrossing(start,
+                              end,
+                              footprint.corners[i],
+                              footprint.corners[(i + 1) % 4])) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef BPT_GEOMETRY_HPP
+#define BPT_GEOMETRY_HPP
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/Footprint.hpp>
+
+namespace bpt
+{
+  // Footprint-based counterparts of the CoreX rectangle tests. These reuse
+  // the precomputed corners and axes instead of recomputing them per call.
+  bool areFootprintsIntersecting(const Footprint& footprintA,
+                                 const Footprint& footprintB);
+  bool isFootprintWithinNPolygon(const Footprint& footprint,
+                                 const cx::NPolygon& polygon);
+  bool isFootprintIntersectingNPolygon(const Footprint& footprint,
+                                       const cx::NPolygon& polygon);
+  bool isPointWithinFootprint(const cx::Point& point,
+                              const Footprint& footprint);
+  bool isPointWithinNPolygon(const cx::Point& point,
+                             const cx::NPolygon& polygon);
+  bool isEdgeCrossingRightRay(const cx::Point& edgeStart,
+                              const cx::Point& edgeEnd,
+                              const cx::Point& rayOrigin);
+  bool areSegmentsCrossing(const cx::Point& startA,
+                           const cx::Point& endA,
+                           const cx::Point& startB,
+                           const cx::Point& endB);
+  bool isSegmentIntersectingFootprint(const cx::Point& start,
+                                      const cx::Point& end,
+                                      const Footprint& footprint);
+  // Areas used to measure how much a layout violates its constraints.
+  float computeFootprintOverlapArea(const Footprint& footprintA,
+                                    const Footprint& footprintB);
+  float computeFootprintAreaOutsideNPolygon(const Footprint& footprint,
+                                            const cx::NPolygon& polygon);
+}
+
+#endif
@@ -0,0 +1,678 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/ds/FlowMatrix.hpp>
+#include <bpt/ds/InputBuilding.hpp>
+#include <bpt/ds/ProblemInstance.hpp>
+#include <bpt/ds/RunResult.hpp>
+#include <bpt/ds/Solution.hpp>
+#include <bpt/GAParameters.hpp>
+#include <bpt/io.hpp>
+#include <bpt/SelectionType.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    constexpr char problemInstanceMagic[4] = { 'B', 'P', 'T', 'P' };
+    constexpr char runResultMagic[4] = { 'B', 'P', 'T', 'R' };
+
+    // Writes values through the buffering of the file, so that large
+    // results are streamed rather than built up in memory first. Errors
+    // are sticky, and only checked once everything has been written.
+    class FileWriter
+    {
+    public:
+      FileWriter(const eastl::string& filePath)
+          : file(std::fopen(filePath.c_str(), "wb")) {}
+
+      ~FileWriter()
+      {
+        if (this->file != nullptr) {
+          std::fclose(this->file);
+        }
+      }
+
+      FileWriter(const FileWriter& other) = delete;
+      FileWriter& operator=(const FileWriter& other) = delete;
+
+      bool isOpen() const
+      {
+        return this->file != nullptr;
+      }
+
+      void writeBytes(const void* bytes, const size_t numBytes)
+      {
+        std::fwrite(bytes, 1, numBytes, this->file);
+      }
+
+      void writeUInt8(const uint8_t value)
+      {
+        this->writeBytes(&value, 1);
+      }
+
+      void writeUInt32(const uint32_t value)
+      {
+        const uint8_t bytes[4] = {
+          static_cast<uint8_t>(value),
+          static_cast<uint8_t>(value >> 8),
+          static_cast<uint8_t>(value >> 16),
+          static_cast<uint8_t>(value >> 24)
+        };
+        this->writeBytes(bytes, sizeof(bytes));
+      }
+
+      void writeUInt64(const uint64_t value)
+      {
+        this->writeUInt32(static_cast<uint32_t>(value));
+        this->writeUInt32(static_cast<uint32_t>(value >> 32));
+      }
+
+      void writeInt32(const int32_t value)
+      {
+        this->writeUInt32(static_cast<uint32_t>(value));
+      }
+
+      void writeFloat(const float value)
+      {
+        static_assert(sizeof(float) == sizeof(uint32_t));
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        this->writeUInt32(bits);
+      }
+
+      void writeDouble(const double value)
+      {
+        static_assert(sizeof(double) == sizeof(uint64_t));
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        this->writeUInt64(bits);
+      }
+
+      void writeSize(const size_t size)
+      {
+        assert(size <= UINT32_MAX);
+        this->writeUInt32(static_cast<uint32_t>(size));
+      }
+
+      void writeFloats(const eastl::vector<float>& values)
+      {
+        this->writeSize(values.size());
+        for (const float value : values) {
+          this->writeFloat(value);
+        }
+      }
+
+      void writePolygon(const cx::NPolygon& polygon)
+      {
+        this->writeSize(polygon.vertices.size());
+        for (const cx::Point& vertex : polygon.vertices) {
+          this->writeFloat(vertex.x);
+          this->writeFloat(vertex.y);
+        }
+      }
+
+      void writePolygons(const eastl::vector<cx::NPolygon>& polygons)
+      {
+        this->writeSize(polygons.size());
+        for (const cx::NPolygon& polygon : polygons) {
+          this->writePolygon(polygon);
+        }
+      }
+
+      void writeParameters(const GAParameters& parameters)
+      {
+        this->writeFloat(parameters.mutationRate);
+        this->writeInt32(parameters.populationSize);
+        this->writeInt32(parameters.numGenerations);
+        this->writeInt32(parameters.tournamentSize);
+        this->writeInt32(parameters.numPrevGenOffsprings);
+        this->writeUInt8(parameters.isLocalSearchEnabled ? 1 : 0);
+        this->writeUInt8(static_cast<uint8_t>(parameters.selectionType));
+      }
+
+      void writeSolution(const Solution& solution)
+      {
+        this->writeDouble(solution.getFitness());
+        for (int i = 0; i < solution.getNumBuildings(); i++) {
+          this->writeFloat(solution.getBuildingXPos(i));
+          this->writeFloat(solution.getBuildingYPos(i));
+          this->writeFloat(solution.getBuildingRotation(i));
+        }
+      }
+
+      long tell() const
+      {
+        return std::ftell(this->file);
+      }
+
+      bool seek(const long offset)
+      {
+        return std::fseek(this->file, offset, SEEK_SET) == 0;
+      }
+
+      bool close()
+      {
+        const bool hasWriteFailed = std::ferror(this->file) != 0;
+        const bool isClosed = std::fclose(this->file) == 0;
+        this->file = nullptr;
+
+        return isClosed && !hasWriteFailed;
+      }
+    private:
+      std::FILE* file;
+    };
+
+    // Reads values from a file loaded in memory. Reading past the end fails
+    // the read and every later one.
+    class BufferReader
+    {
+    public:
+      BufferReader(const eastl::vector<uint8_t>& buffer)
+          : cursor(buffer.data())
+          , end(buffer.data() + buffer.size())
+          , hasFailed(false) {}
+
+      bool isValid() const
+      {
+        return !this->hasFailed;
+      }
+
+      bool isAtEnd() const
+      {
+        return this->cursor == this->end;
+      }
+
+      bool readBytes(void* bytes, const size_t numBytes)
+      {
+        if (this->hasFailed
+            || static_cast<size_t>(this->end - this->cursor) < numBytes) {
+          this->hasFailed = true;
+          std::memset(bytes, 0, numBytes);
+          return false;
+        }
+
+        std::memcpy(bytes, this->cursor, numBytes);
+        this->cursor += numBytes;
+
+        return true;
+      }
+
+      uint8_t readUInt8()
+      {
+        uint8_t value;
+        this->readBytes(&value, 1);
+        return value;
+      }
+
+      uint32_t readUInt32()
+      {
+        uint8_t bytes[4];
+        this->readBytes(bytes, sizeof(bytes));
+        return static_cast<uint32_t>(bytes[0])
+               | (static_cast<uint32_t>(bytes[1]) << 8)
+               | (static_cast<uint32_t>(bytes[2]) << 16)
+               | (static_cast<uint32_t>(bytes[3]) << 24);
+      }
+
+      uint64_t readUInt64()
+      {
+        const uint64_t low = this->readUInt32();
+        const uint64_t high = this->readUInt32();
+        return low | (high << 32);
+      }
+
+      int32_t readInt32()
+      {
+        return static_cast<int32_t>(this->readUInt32());
+      }
+
+      float readFloat()
+      {
+        const uint32_t bits = this->readUInt32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      double readDouble()
+      {
+        const uint64_t bits = this->readUInt64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      bool hasRemainingItems(const size_t numItems,
+                             const size_t itemSize) const
+      {
+        const auto numRemainingBytes = static_cast<size_t>(
+            this->end - this->cursor);
+        return itemSize == 0 || numItems <= numRemainingBytes / itemSize;
+      }
+
+      // Reads a count of items that take up at least minItemSize bytes
+      // each. Counts that the rest of the buffer cannot hold fail the read,
+      // so that corrupt files do not cause huge allocations.
+      size_t readCount(const size_t minItemSize)
+      {
+        const size_t count = this->readUInt32();
+        if (!this->hasRemainingItems(count, minItemSize)) {
+          this->hasFailed = true;
+          return 0;
+        }
+
+        return count;
+      }
+
+      void readFloats(eastl::vector<float>& values)
+      {
+        values.resize(this->readCount(sizeof(float)));
+        for (float& value : values) {
+          value = this->readFloat();
+        }
+      }
+
+      void readPolygon(cx::NPolygon& polygon)
+      {
+        polygon.vertices.resize(this->readCount(sizeof(float) * 2));
+        for (cx::Point& vertex : polygon.vertices) {
+          vertex.x = this->readFloat();
+          vertex.y = this->readFloat();
+        }
+
+        if (polygon.vertices.size() < 3) {
+          this->hasFailed = true;
+        }
+      }
+
+      void readPolygons(eastl::vector<cx::NPolygon>& polygons)
+      {
+        polygons.resize(this->readCount(sizeof(uint32_t)));
+        for (cx::NPolygon& polygon : polygons) {
+          this->readPolygon(polygon);
+        }
+      }
+
+      void readParameters(GAParameters& parameters)
+      {
+        parameters.mutationRate = this->readFloat();
+        parameters.populationSize = this->readInt32();
+        parameters.numGenerations = this->readInt32();
+        parameters.tournamentSize = this->readInt32();
+        parameters.numPrevGenOffsprings = this->readInt32();
+
+        const uint8_t isLocalSearchEnabled = this->readUInt8();
+        const uint8_t selectionType = this->readUInt8();
+        if (!areGAParametersValid(parameters)
+            || isLocalSearchEnabled > 1
+            || selectionType > static_cast<uint8_t>(SelectionType::TS)) {
+          this->hasFailed = true;
+        }
+
+        parameters.isLocalSearchEnabled = isLocalSearchEnabled == 1;
+        parameters.selectionType = static_cast<SelectionType>(selectionType);
+      }
+
+      void readSolution(Solution& solution, const int numBuildings)
+      {
+        solution = Solution{ numBuildings };
+        solution.setFitness(this->readDouble());
+        for (int i = 0; i < numBuildings; i++) {
+          solution.setBuildingXPos(i, this->readFloat());
+          solution.setBuildingYPos(i, this->readFloat());
+          solution.setBuildingRotation(i, this->readFloat());
+        }
+      }
+    private:
+      const uint8_t* cursor;
+      const uint8_t* end;
+      bool hasFailed;
+    };
+
+    bool loadFile(const eastl::string& filePath,
+                  eastl::vector<uint8_t>& buffer)
+    {
+      std::FILE* file = std::fopen(filePath.c_str(), "rb");
+      if (file == nullptr) {
+        return false;
+      }
+
+      buffer.clear();
+
+      uint8_t chunk[1 << 16];
+      size_t numReadBytes;
+      while ((numReadBytes = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + numReadBytes);
+      }
+
+      const bool hasReadFailed = std::ferror(file) != 0;
+      std::fclose(file);
+
+      return !hasReadFailed;
+    }
+
+    // Resolves a path relative to the directory of the given file.
+    eastl::string resolveRelativeFilePath(const eastl::string& baseFilePath,
+                                          const eastl::string& filePath)
+    {
+      const size_t separatorIndex = baseFilePath.rfind('/');
+      if (filePath.front() == '/' || separatorIndex == eastl::string::npos) {
+        return filePath;
+      }
+
+      return baseFilePath.substr(0, separatorIndex + 1) + filePath;
+    }
+
+    bool readHeader(BufferReader& reader,
+                    const char (&magic)[4],
+                    const uint32_t version)
+    {
+      char fileMagic[4];
+      reader.readBytes(fileMagic, sizeof(fileMagic));
+      const uint32_t fileVersion = reader.readUInt32();
+
+      return reader.isValid()
+             && std::memcmp(fileMagic, magic, sizeof(magic)) == 0
+             && fileVersion == version;
+    }
+  }
+
+  bool writeProblemInstance(const eastl::string& filePath,
+                            const ProblemInstance& instance)
+  {
+    const size_t numBuildings = instance.inputBuildings.size();
+    assert(!instance.flowMatrixFilePath.empty()
+           || instance.flowRates.getNumBuildings() == numBuildings);
+
+    FileWriter writer{ filePath };
+    if (!writer.isOpen()) {
+      return false;
+    }
+
+    writer.writeBytes(problemInstanceMagic, sizeof(problemInstanceMagic));
+    writer.writeUInt32(problemInstanceFileVersion);
+
+    writer.writeSize(numBuildings);
+    for (const InputBuilding& building : instance.inputBuildings) {
+      writer.writeFloat(building.length);
+      writer.writeFloat(building.width);
+    }
+
+    writer.writePolygon(instance.boundingArea);
+
+    writer.writeSize(instance.flowMatrixFilePath.size());
+    if (instance.flowMatrixFilePath.empty()) {
+      for (int i = 0; i < numBuildings; i++) {
+        for (int j = 0; j < numBuildings; j++) {
+          writer.writeFloat(instance.flowRates.getFlowRate(i, j));
+        }
+      }
+    } else {
+      writer.writeBytes(instance.flowMatrixFilePath.data(),
+                        instance.flowMatrixFilePath.size());
+    }
+
+    writer.writePolygons(instance.floodProneAreas);
+    writer.writePolygons(instance.landslideProneAreas);
+    writer.writeFloat(instance.floodProneAreaPenalty);
+    writer.writeFloat(instance.landslideProneAreaPenalty);
+    writer.writeFloat(instance.buildingDistanceWeight);
+    writer.writeFloats(instance.allowedOrientations);
+    writer.writeParameters(instance.parameters);
+
+    return writer.close();
+  }
+
+  bool writeRunResult(const eastl::string& filePath, const RunResult& result)
+  {
+    int numBuildings = 0;
+    for (const eastl::vector<Solution>& generation : result.solutions) {
+      if (!generation.empty()) {
+        numBuildings = generation[0].getNumBuildings();
+        break;
+      }
+    }
+
+    FileWriter writer{ filePath };
+    if (!writer.isOpen()) {
+      return false;
+    }
+
+    writer.writeBytes(runResultMagic, sizeof(runResultMagic));
+    writer.writeUInt32(runResultFileVersion);
+    writer.writeParameters(result.parameters);
+    writer.writeSize(static_cast<size_t>(numBuildings));
+    writer.writeFloats(result.averageFitnesses);
+    writer.writeFloats(result.bestFitnesses);
+    writer.writeFloats(result.worstFitnesses);
+    writer.writeFloats(result.fitnessCacheHitRates);
+
+    writer.writeSize(result.solutions.size());
+    for (const eastl::vector<Solution>& generation : result.solutions) {
+      writer.writeSize(generation.size());
+      for (const Solution& solution : generation) {
+        assert(solution.getNumBuildings() == numBuildings);
+        writer.writeSolution(solution);
+      }
+    }
+
+    return writer.close();
+  }
+
+  bool readProblemInstance(const eastl::string& filePath,
+                           ProblemInstance& instance)
+  {
+    eastl::vector<uint8_t> buffer;
+    if (!loadFile(filePath, buffer)) {
+      return false;
+    }
+
+    BufferReader reader{ buffer };
+    if (!readHeader(reader, problemInstanceMagic, problemInstanceFileVersion)) {
+      return false;
+    }
+
+    const size_t numBuildings = reader.readCount(sizeof(float) * 2);
+    instance.inputBuildings.resize(numBuildings);
+    for (InputBuilding& building : instance.inputBuildings) {
+      building.length = reader.readFloat();
+      building.width = reader.readFloat();
+    }
+
+    reader.readPolygon(instance.boundingArea);
+
+    instance.flowMatrixFilePath.resize(reader.readCount(1));
+    reader.readBytes(instance.flowMatrixFilePath.data(),
+                     instance.flowMatrixFilePath.size());
+    if (!reader.isValid()) {
+      return false;
+    }
+
+    if (instance.flowMatrixFilePath.empty()) {
+      // Checked up front, since the matrix has no count of its own.
+      if (!reader.hasRemainingItems(numBuildings * numBuildings,
+                                    sizeof(float))) {
+        return false;
+      }
+
+      eastl::vector<float> flowRates(numBuildings * numBuildings);
+      for (float& flowRate : flowRates) {
+        flowRate = reader.readFloat();
+      }
+
+      instance.flowRates = FlowMatrix{
+        static_cast<int>(numBuildings),
+        flowRates.data()
+      };
+    } else {
+      const eastl::string flowMatrixFilePath = resolveRelativeFilePath(
+          filePath, instance.flowMatrixFilePath);
+      if (!instance.flowRates.mapFile(flowMatrixFilePath)
+          || instance.flowRates.getNumBuildings() != numBuildings) {
+        return false;
+      }
+    }
+
+    reader.readPolygons(instance.floodProneAreas);
+    reader.readPolygons(instance.landslideProneAreas);
+    instance.floodProneAreaPenalty = reader.readFloat();
+    instance.landslideProneAreaPenalty = reader.readFloat();
+    instance.buildingDistanceWeight = reader.readFloat();
+    reader.readFloats(instance.allowedOrientations);
+    reader.readParameters(instance.parameters);
+
+    return reader.isValid() && reader.isAtEnd();
+  }
+
+  bool readRunResult(const eastl::string& filePath, RunResult& result)
+  {
+    eastl::vector<uint8_t> buffer;
+    if (!loadFile(filePath, buffer)) {
+      return false;
+    }
+
+    BufferReader reader{ buffer };
+    if (!readHeader(reader, runResultMagic, runResultFileVersion)) {
+      return false;
+    }
+
+    reader.readParameters(result.parameters);
+
+    const size_t numBuildings = reader.readUInt32();
+    const size_t solutionSize = sizeof(double)
+                                + (sizeof(float) * 3 * numBuildings);
+    if (numBuildings > INT32_MAX / 3) {
+      return false;
+    }
+
+    reader.readFloats(result.averageFitnesses);
+    reader.readFloats(result.bestFitnesses);
+    reader.readFloats(result.worstFitnesses);
+    reader.readFloats(result.fitnessCacheHitRates);
+
+    result.solutions.resize(reader.readCount(sizeof(uint32_t)));
+    for (eastl::vector<Solution>& generation : result.solutions) {
+      generation.resize(reader.readCount(solutionSize));
+      for (Solution& solution : generation) {
+        reader.readSolution(solution, static_cast<int>(numBuildings));
+      }
+    }
+
+    return reader.isValid() && reader.isAtEnd();
+  }
+
+  struct RunResultWriter::State
+  {
+    explicit State(const eastl::string& filePath)
+        : writer(filePath)
+        , numBuildings(0)
+        , numStatistics(0)
+        , numSolutionGenerations(0)
+        , numWrittenGenerations(0)
+        , statisticsOffset(0) {}
+
+    FileWriter writer;
+    int numBuildings;
+    size_t numStatistics;
+    int numSolutionGenerations;
+    int numWrittenGenerations;
+    long statisticsOffset;
+  };
+
+  RunResultWriter::RunResultWriter()
+      : state() {}
+
+  RunResultWriter::~RunResultWriter() = default;
+
+  bool RunResultWriter::open(const eastl::string& filePath,
+                             const GAParameters& parameters,
+                             const int numBuildings,
+                             const int numStatistics,
+                             const int numSolutionGenerations)
+  {
+    assert(numBuildings >= 0);
+    assert(numStatistics >= 0 && numSolutionGenerations >= 0);
+
+    this->state = eastl::make_unique<State>(filePath);
+    if (!this->state->writer.isOpen()) {
+      this->state.reset();
+      return false;
+    }
+
+    State& state = *this->state;
+    state.numBuildings = numBuildings;
+    state.numStatistics = static_cast<size_t>(numStatistics);
+    state.numSolutionGenerations = numSolutionGenerations;
+
+    FileWriter& writer = state.writer;
+    writer.writeBytes(runResultMagic, sizeof(runResultMagic));
+    writer.writeUInt32(runResultFileVersion);
+    writer.writeParameters(parameters);
+    writer.writeSize(static_cast<size_t>(numBuildings));
+
+    // Room for the four statistics, which are filled in when closing.
+    state.statisticsOffset = writer.tell();
+    const eastl::vector<float> placeholders(numStatistics, 0.f);
+    for (int i = 0; i < 4; i++) {
+      writer.writeFloats(placeholders);
+    }
+
+    writer.writeSize(static_cast<size_t>(numSolutionGenerations));
+
+    return true;
+  }
+
+  void RunResultWriter::writeGeneration(
+      const eastl::vector<Solution>& solutions)
+  {
+    assert(this->state);
+    State& state = *this->state;
+    assert(state.numWrittenGenerations < state.numSolutionGenerations);
+
+    state.writer.writeSize(solutions.size());
+    for (const Solution& solution : solutions) {
+      assert(solution.getNumBuildings() == state.numBuildings);
+      state.writer.writeSolution(solution);
+    }
+
+    state.numWrittenGenerations++;
+  }
+
+  bool RunResultWriter::close(const eastl::vector<float>& averageFitnesses,
+                              const eastl::vector<float>& bestFitnesses,
+                              const eastl::vector<float>& worstFitnesses,
+                              const eastl::vector<float>& fitnessCacheHitRates)
+  {
+    assert(this->state);
+    State& state = *this->state;
+    assert(state.numWrittenGenerations == state.numSolutionGenerations);
+    assert(averageFitnesses.size() == state.numStatistics
+           && bestFitnesses.size() == averageFitnesses.size()
+           && worstFitnesses.size() == averageFitnesses.size()
+           && fitnessCacheHitRates.size() == averageFitnesses.size());
+
+    FileWriter& writer = state.writer;
+    bool isWritten = state.statisticsOffset >= 0
+                     && writer.seek(state.statisticsOffset);
+    if (isWritten) {
+      writer.writeFloats(averageFitnesses);
+      writer.writeFloats(bestFitnesses);
+      writer.writeFloats(worstFitnesses);
+      writer.writeFloats(fitnessCacheHitRates);
+    }
+
+    isWritten = writer.close() && isWritten;
+    this->state.reset();
+
+    return isWritten;
+  }
+}
@@ -0,0 +1,103 @@
+#ifndef BPT_IO_HPP
+#define BPT_IO_HPP
+
+#include <cstdint>
+
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <bpt/ds/ProblemInstance.hpp>
+#include <bpt/ds/RunResult.hpp>
+#include <bpt/ds/Solution.hpp>
+#include <bpt/GAParameters.hpp>
+
+namespace bpt
+{
+  // Binary files for running the GA without going through the bindings.
+  // Both kinds of files start with a four-byte magic ("BPTP" for problem
+  // instances, "BPTR" for run results) and a 32-bit format version. All
+  // values are little-endian, with floats and doubles in IEEE 754 format.
+  //
+  // A problem instance file holds, in order:
+  //   - the number of buildings n (uint32) and, per building, its length
+  //     and width (float)
+  //   - the site polygon
+  //   - the length of the flow matrix file path (uint32) and the path, in
+  //     UTF-8 with no terminator, or a length of zero and the flow rates,
+  //     as an n x n row-major matrix of floats
+  //   - the number of flood-prone areas (uint32) and their polygons
+  //   - the number of landslide-prone areas (uint32) and their polygons
+  //   - the flood-prone and landslide-prone area penalties and the
+  //     building distance weight (float)
+  //   - the number of allowed orientations (uint32) and the orientations
+  //     (float)
+  //   - the GA parameters: the mutation rate (float), the population size,
+  //     number of generations, tournament size and number of offsprings
+  //     kept from the previous generation (int32), whether local search is
+  //     enabled (uint8) and the selection type (uint8)
+  // A polygon is its number of vertices (uint32) and then the x and y
+  // coordinates of each vertex (float).
+  //
+  // A run result file holds the GA parameters, as above, then the number
+  // of buildings (uint32), and the average, best and worst fitnesses and
+  // fitness cache hit rates per generation, each as a count (uint32)
+  // followed by the values (float). Then comes the number of generations
+  // with solutions (uint32), and for each one, the number of its solutions
+  // (uint32) and the solutions. A solution is its fitness (double) and then
+  // the x position, y position and rotation of each building (float).
+  constexpr uint32_t problemInstanceFileVersion = 2;
+  constexpr uint32_t runResultFileVersion = 1;
+
+  // Both return false if the file cannot be written.
+  bool writeProblemInstance(const eastl::string& filePath,
+                            const ProblemInstance& instance);
+  bool writeRunResult(const eastl::string& filePath,
+                      const RunResult& result);
+  // Both return false if the file cannot be read, is not of the expected
+  // kind or version, or is malformed, e.g. has GA parameters that cannot be
+  // run (see areGAParametersValid()), and readProblemInstance() also if the
+  // flow matrix file it refers to cannot be mapped or has the wrong size.
+  // The output is left in an unspecified state then.
+  bool readProblemInstance(const eastl::string& filePath,
+                           ProblemInstance& instance);
+  bool readRunResult(const eastl::string& filePath, RunResult& result);
+
+  // Writes a run result file while the run goes on, one generation of
+  // solutions at a time, so that they need not all be kept in memory. The
+  // statistics come before the solutions in the file, but are only complete
+  // at the end of the run, so room is left for them and they are filled in
+  // when closing. The file must therefore be seekable.
+  class RunResultWriter
+  {
+  public:
+    RunResultWriter();
+    ~RunResultWriter();
+
+    RunResultWriter(const RunResultWriter& other) = delete;
+    RunResultWriter& operator=(const RunResultWriter& other) = delete;
+
+    // Writes everything before the solutions. Each statistic will have
+    // numStatistics values, and the solutions of numSolutionGenerations
+    // generations will be written. Returns false if the file cannot be
+    // opened.
+    bool open(const eastl::string& filePath,
+              const GAParameters& parameters,
+              const int numBuildings,
+              const int numStatistics,
+              const int numSolutionGenerations);
+    void writeGeneration(const eastl::vector<Solution>& solutions);
+    // Every generation must have been written by then. Returns false if
+    // anything could not be written.
+    bool close(const eastl::vector<float>& averageFitnesses,
+               const eastl::vector<float>& bestFitnesses,
+               const eastl::vector<float>& worstFitnesses,
+               const eastl::vector<float>& fitnessCacheHitRates);
+  private:
+    struct State;
+
+    eastl::unique_ptr<State> state;
+  };
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef BPT_OPERATORS_HPP
+#define BPT_OPERATORS_HPP
+
+namespace bpt
+{
+  // Operator policies of the GA. Each policy is a tag type that picks, at
+  // compile time, the GA operator overload to use, so that the operators can
+  // be inlined into the GA loop.
+
+  // Selection policies.
+  struct RouletteWheelSelection {};
+  struct TournamentSelection {};
+
+  // Crossover policies.
+  struct UniformCrossover {};
+
+  // Mutation policies.
+  struct BuddyBuddyMutation {};
+  struct ShakingMutation {};
+  struct JiggleMutation {};
+
+  // Applies one of the mutations above, chosen uniformly at random.
+  struct RandomMutation {};
+  // Applies one of the mutations above, chosen by an adaptive operator
+  // selector (see bpt/AdaptiveOperatorSelector.hpp).
+  struct AdaptiveMutation {};
+}
+
+#endif
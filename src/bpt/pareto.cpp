@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <limits>
+
+#include <EASTL/vector.h>
+
+#include <bpt/pareto.hpp>
+
+namespace bpt
+{
+  bool doesObjectiveVectorDominate(const ObjectiveVector& objectivesA,
+                                   const ObjectiveVector& objectivesB)
+  {
+    bool isStrictlyBetterSomewhere = false;
+    for (int i = 0; i < numObjectives; i++) {
+      if (objectivesA[i] > objectivesB[i]) {
+        return false;
+      }
+
+      if (objectivesA[i] < objectivesB[i]) {
+        isStrictlyBetterSomewhere = true;
+      }
+    }
+
+    return isStrictlyBetterSomewhere;
+  }
+
+  eastl::vector<eastl::vector<int>> sortIntoNonDominatedFronts(
+      const eastl::vector<ObjectiveVector>& objectives)
+  {
+    const int numVectors = static_cast<int>(objectives.size());
+    eastl::vector<eastl::vector<int>> dominatedVectors(numVectors);
+    eastl::vector<int> numDominators(numVectors, 0);
+    eastl::vector<eastl::vector<int>> fronts;
+
+    eastl::vector<int> currentFront;
+    for (int i = 0; i < numVectors; i++) {
+      for (int j = i + 1; j < numVectors; j++) {
+        if (doesObjectiveVectorDominate(objectives[i], objectives[j])) {
+          dominatedVectors[i].push_back(j);
+          numDominators[j]++;
+        } else if (doesObjectiveVectorDominate(objectives[j], objectives[i])) {
+          dominatedVectors[j].push_back(i);
+          numDominators[i]++;
+        }
+      }
+    }
+
+    for (int i = 0; i < numVectors; i++) {
+      if (numDominators[i] == 0) {
+        currentFront.push_back(i);
+      }
+    }
+
+    while (!currentFront.empty()) {
+      eastl::vector<int> nextFront;
+      for (int i : currentFront) {
+        for (int j : dominatedVectors[i]) {
+          numDominators[j]--;
+          if (numDominators[j] == 0) {
+            nextFront.push_back(j);
+          }
+        }
+      }
+
+      fronts.push_back(currentFront);
+      currentFront = nextFront;
+    }
+
+    return fronts;
+  }
+
+  eastl::vector<double> computeCrowdingDistances(
+      const eastl::vector<ObjectiveVector>& objectives,
+      const eastl::vector<int>& front)
+  {
+    const int frontSize = static_cast<int>(front.size());
+    eastl::vector<double> distances(frontSize, 0.0);
+    if (frontSize <= 2) {
+      std::fill(distances.begin(),
+                distances.end(),
+                std::numeric_limits<double>::infinity());
+      return distances;
+    }
+
+    // Positions in the front, sorted per objective.
+    eastl::vector<int> order(frontSize);
+    for (int m = 0; m < numObjectives; m++) {
+      for (int i = 0; i < frontSize; i++) {
+        order[i] = i;
+      }
+
+      std::sort(order.begin(),
+                order.end(),
+                [&objectives, &front, m](int a, int b) {
+                  return objectives[front[a]][m] < objectives[front[b]][m];
+                });
+
+      const double minValue = objectives[front[order.front()]][m];
+      const double maxValue = objectives[front[order.back()]][m];
+      distances[order.front()] = std::numeric_limits<double>::infinity();
+      distances[order.back()] = std::numeric_limits<double>::infinity();
+      if (maxValue <= minValue) {
+        continue;
+      }
+
+      for (int i = 1; i < frontSize - 1; i++) {
+        distances[order[i]] += (objectives[front[order[i + 1]]][m]
+                                - objectives[front[order[i - 1]]][m])
+                               / (maxValue - minValue);
+      }
+    }
+
+    return distances;
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef BPT_PARETO_HPP
+#define BPT_PARETO_HPP
+
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+namespace bpt
+{
+  // Objectives used in multi-objective runs, all of which are minimized:
+  //   [ flow cost, flood-prone area exposure, landslide-prone area exposure ]
+  // Exposures are the number of building-area intersections.
+  constexpr int numObjectives = 3;
+  using ObjectiveVector = eastl::array<double, numObjectives>;
+
+  bool doesObjectiveVectorDominate(const ObjectiveVector& objectivesA,
+                                   const ObjectiveVector& objectivesB);
+
+  // Fast non-dominated sort from Deb et al.'s NSGA-II paper. Returns the
+  // indices of the objective vectors in each front, starting with the
+  // non-dominated front.
+  eastl::vector<eastl::vector<int>> sortIntoNonDominatedFronts(
+    const eastl::vector<ObjectiveVector>& objectives);
+
+  // Crowding distances of the members of a front, in the same order as the
+  // front. Boundary members get an infinite distance.
+  eastl::vector<double> computeCrowdingDistances(
+    const eastl::vector<ObjectiveVector>& objectives,
+    const eastl::vector<int>& front);
+}
+
+#endif
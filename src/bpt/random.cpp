@@ -0,0 +1,26 @@
+#include <cstdint>
+#include <random>
+
+#include <bpt/random.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    std::mt19937& getThreadRandomEngine()
+    {
+      thread_local std::mt19937 engine{ std::random_device{}() };
+      return engine;
+    }
+  }
+
+  std::mt19937& getRandomEngine()
+  {
+    return getThreadRandomEngine();
+  }
+
+  void seedRandomEngine(uint32_t seed)
+  {
+    getThreadRandomEngine().seed(seed);
+  }
+}
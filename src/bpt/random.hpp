@@ -0,0 +1,27 @@
+#ifndef BPT_RANDOM_HPP
+#define BPT_RANDOM_HPP
+
+#include <cstdint>
+#include <random>
+
+namespace bpt
+{
+  // Every thread has its own random engine, so that GA runs in different
+  // threads do not share (and race on) random state.
+  std::mt19937& getRandomEngine();
+  void seedRandomEngine(uint32_t seed);
+
+  template <typename T>
+  T generateRandomReal(std::uniform_real_distribution<T>& distribution)
+  {
+    return distribution(getRandomEngine());
+  }
+
+  template <typename T>
+  T generateRandomInt(std::uniform_int_distribution<T>& distribution)
+  {
+    return distribution(getRandomEngine());
+  }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+
+#include <bpt/tracing.hpp>
+
+namespace bpt
+{
+  namespace
+  {
+    // Must be a power of two.
+    constexpr uint64_t traceBufferCapacity = 1 << 16;
+
+    struct TraceEvent
+    {
+      const char* name;
+      uint64_t startTime;
+      uint64_t duration;
+    };
+
+    struct TraceBuffer
+    {
+      int threadID;
+      eastl::vector<TraceEvent> events;
+      // Only written by the thread owning the buffer.
+      std::atomic<uint64_t> numEvents;
+    };
+
+    // Buffers are never freed, so that the spans of threads that have
+    // ended can still be exported. Instead, the buffer of a thread that has
+    // ended is handed to the next new thread, which records after the spans
+    // already in it. There are thus only as many buffers as threads that
+    // ever traced at the same time, even if threads are started over and
+    // over, e.g. for every batch of solutions to score.
+    std::mutex traceBuffersMutex;
+    eastl::vector<eastl::unique_ptr<TraceBuffer>> traceBuffers;
+    eastl::vector<TraceBuffer*> freeTraceBuffers;
+
+    // Gives the buffer of its thread back when the thread ends.
+    class TraceBufferOwner
+    {
+    public:
+      TraceBufferOwner()
+          : buffer(nullptr) {}
+
+      ~TraceBufferOwner()
+      {
+        if (this->buffer != nullptr) {
+          std::lock_guard<std::mutex> lock{ traceBuffersMutex };
+          freeTraceBuffers.push_back(this->buffer);
+        }
+      }
+
+      TraceBufferOwner(const TraceBufferOwner& other) = delete;
+      TraceBufferOwner& operator=(const TraceBufferOwner& other) = delete;
+
+      TraceBuffer* buffer;
+    };
+
+    TraceBuffer& getThreadTraceBuffer()
+    {
+      thread_local TraceBufferOwner owner;
+      if (owner.buffer == nullptr) {
+        std::lock_guard<std::mutex> lock{ traceBuffersMutex };
+
+        if (freeTraceBuffers.empty()) {
+          auto newBuffer = eastl::make_unique<TraceBuffer>();
+          newBuffer->threadID = static_cast<int>(traceBuffers.size());
+          newBuffer->events.resize(traceBufferCapacity);
+          newBuffer->numEvents.store(0);
+
+          owner.buffer = newBuffer.get();
+          traceBuffers.push_back(eastl::move(newBuffer));
+        } else {
+          owner.buffer = freeTraceBuffers.back();
+          freeTraceBuffers.pop_back();
+        }
+      }
+
+      return *owner.buffer;
+    }
+
+    // Span names are written as JSON strings, so quotes, backslashes and
+    // control characters in them must be escaped.
+    void writeJSONString(std::FILE* file, const char* text)
+    {
+      std::fputc('"', file);
+      for (const char* c = text; *c != '\0'; c++) {
+        const auto character = static_cast<unsigned char>(*c);
+        if (character == '"' || character == '\\') {
+          std::fputc('\\', file);
+          std::fputc(character, file);
+        } else if (character < 0x20) {
+          std::fprintf(file, "\\u%04x", character);
+        } else {
+          std::fputc(character, file);
+        }
+      }
+
+      std::fputc('"', file);
+    }
+
+    // In nanoseconds, since the first call.
+    uint64_t getTraceTime()
+    {
+      using Clock = std::chrono::steady_clock;
+      static const Clock::time_point traceEpoch = Clock::now();
+      return static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              Clock::now() - traceEpoch).count());
+    }
+
+    void recordTraceEvent(const char* name,
+                          const uint64_t startTime,
+                          const uint64_t duration)
+    {
+      TraceBuffer& buffer = getThreadTraceBuffer();
+      const uint64_t eventIndex = buffer.numEvents.load(
+          std::memory_order_relaxed);
+      buffer.events[eventIndex & (traceBufferCapacity - 1)] = TraceEvent{
+        name,
+        startTime,
+        duration
+      };
+      buffer.numEvents.store(eventIndex + 1, std::memory_order_release);
+    }
+  }
+
+  TraceSpan::TraceSpan(const char* name)
+      : name(name)
+      , startTime(getTraceTime()) {}
+
+  TraceSpan::~TraceSpan()
+  {
+    recordTraceEvent(this->name,
+                     this->startTime,
+                     getTraceTime() - this->startTime);
+  }
+
+  void clearTrace()
+  {
+    std::lock_guard<std::mutex> lock{ traceBuffersMutex };
+    for (auto& buffer : traceBuffers) {
+      buffer->numEvents.store(0, std::memory_order_release);
+    }
+  }
+
+  bool exportChromeTrace(const eastl::string& filePath)
+  {
+    std::FILE* file = std::fopen(filePath.c_str(), "w");
+    if (file == nullptr) {
+      return false;
+    }
+
+    std::fputs("{\"traceEvents\":[", file);
+
+    bool isFirstEvent = true;
+    {
+      std::lock_guard<std::mutex> lock{ traceBuffersMutex };
+      for (auto& buffer : traceBuffers) {
+        const uint64_t numEvents = buffer->numEvents.load(
+            std::memory_order_acquire);
+        const uint64_t firstEvent = (numEvents > traceBufferCapacity)
+                                    ? numEvents - traceBufferCapacity
+                                    : 0;
+        for (uint64_t i = firstEvent; i < numEvents; i++) {
+          const TraceEvent& event = buffer->events[
+              i & (traceBufferCapacity - 1)];
+
+          // Chrome trace timestamps are in microseconds.
+          std::fputs(isFirstEvent ? "\n{\"name\":" : ",\n{\"name\":", file);
+          writeJSONString(file, event.name);
+          std::fprintf(file,
+                       ",\"ph\":\"X\",\"pid\":1,"
+                       "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                       buffer->threadID,
+                       static_cast<double>(event.startTime) / 1000.0,
+                       static_cast<double>(event.duration) / 1000.0);
+          isFirstEvent = false;
+        }
+      }
+    }
+
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+    const bool hasWriteFailed = std::ferror(file) != 0;
+    return (std::fclose(file) == 0) && !hasWriteFailed;
+  }
+
+  bool isTracingEnabled()
+  {
+#ifdef BPT_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef BPT_TRACING_HPP
+#define BPT_TRACING_HPP
+
+#include <cstdint>
+
+#include <EASTL/string.h>
+
+// Tracing records named spans of time (see TraceSpan), which can then be
+// exported to the Chrome trace format, for viewing in chrome://tracing or
+// Perfetto. Spans are only recorded when libbpt is compiled with
+// BPT_ENABLE_TRACING defined (the BPT_ENABLE_TRACING CMake option).
+// Otherwise, BPT_TRACE_SCOPE() expands to nothing, and the exported traces
+// are empty.
+#ifdef BPT_ENABLE_TRACING
+#define BPT_TRACE_CONCAT_IMPL(a, b) a##b
+#define BPT_TRACE_CONCAT(a, b) BPT_TRACE_CONCAT_IMPL(a, b)
+// Records a span with the given name from here to the end of the scope. The
+// name must be a string literal, or outlive the trace.
+#define BPT_TRACE_SCOPE(name) \
+  ::bpt::TraceSpan BPT_TRACE_CONCAT(bptTraceSpan, __LINE__){ name }
+#else
+#define BPT_TRACE_SCOPE(name) do {} while (false)
+#endif
+
+namespace bpt
+{
+  class TraceSpan
+  {
+  public:
+    explicit TraceSpan(const char* name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan& other) = delete;
+    TraceSpan& operator=(const TraceSpan& other) = delete;
+  private:
+    const char* name;
+    uint64_t startTime;
+  };
+
+  // Every thread records its spans into its own ring buffer, without locks.
+  // Once a buffer is full, the oldest spans of the thread get overwritten.
+  // Buffers of threads that have ended are reused by new threads, whose
+  // spans are then exported under the same thread ID.
+  // Clearing and exporting must only be done while no spans are being
+  // recorded, e.g. between runs.
+  void clearTrace();
+  // Writes the recorded spans to a Chrome trace JSON file. Returns false if
+  // the file could not be written.
+  bool exportChromeTrace(const eastl::string& filePath);
+  bool isTracingEnabled();
+}
+
+#endif
@@ -0,0 +1,218 @@
+// Runs the GA on a problem instance file and writes the result to a run
+// result file (see bpt/io.hpp for both formats), without needing Python.
+// The solutions of each generation are written as soon as it is done, so
+// long runs do not have to keep them all in memory.
+//
+// Usage: bpt-run [options] <problem instance file> <run result file>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <bpt/bpt.hpp>
+
+namespace
+{
+  constexpr const char* usage =
+      "Usage: bpt-run [options] <problem instance file> <run result file>\n"
+      "\n"
+      "Options:\n"
+      "  --seed <seed>                 Seed the random engine.\n"
+      "  --fitness-cache-capacity <n>  Enable the fitness cache.\n"
+      "  --steady-state                Use steady-state replacement.\n"
+      "  --compact                     Use the compact gene encoding.\n"
+      "  --adaptive-mutation           Use adaptive mutation selection.\n"
+      "  --penalty                     Use penalty-based constraint handling.\n"
+      "  --scrambled-halton            Initialize with scrambled Halton\n"
+      "                                sequences.\n"
+      "  --final-only                  Only write the solutions of the final\n"
+      "                                generation.\n";
+
+  struct Options
+  {
+    eastl::string instanceFilePath;
+    eastl::string resultFilePath;
+    bool hasSeed = false;
+    uint32_t seed = 0;
+    int fitnessCacheCapacity = 0;
+    bool isSteadyState = false;
+    bool isCompact = false;
+    bool isMutationSelectionAdaptive = false;
+    bool isPenalized = false;
+    bool isInitializationQuasiRandom = false;
+    bool isFinalOnly = false;
+  };
+
+  bool parseInteger(const char* text, long long& value)
+  {
+    char* end;
+    value = std::strtoll(text, &end, 10);
+    return *text != '\0' && *end == '\0';
+  }
+
+  bool parseOptions(const int argc, char** argv, Options& options)
+  {
+    eastl::vector<eastl::string> positionalArgs;
+    for (int i = 1; i < argc; i++) {
+      const char* arg = argv[i];
+      const bool hasValue = i + 1 < argc;
+      long long value;
+      if (std::strcmp(arg, "--seed") == 0) {
+        if (!hasValue || !parseInteger(argv[++i], value)
+            || value < 0 || value > UINT32_MAX) {
+          return false;
+        }
+
+        options.hasSeed = true;
+        options.seed = static_cast<uint32_t>(value);
+      } else if (std::strcmp(arg, "--fitness-cache-capacity") == 0) {
+        if (!hasValue || !parseInteger(argv[++i], value)
+            || value < 0 || value > INT32_MAX) {
+          return false;
+        }
+
+        options.fitnessCacheCapacity = static_cast<int>(value);
+      } else if (std::strcmp(arg, "--steady-state") == 0) {
+        options.isSteadyState = true;
+      } else if (std::strcmp(arg, "--compact") == 0) {
+        options.isCompact = true;
+      } else if (std::strcmp(arg, "--adaptive-mutation") == 0) {
+        options.isMutationSelectionAdaptive = true;
+      } else if (std::strcmp(arg, "--penalty") == 0) {
+        options.isPenalized = true;
+      } else if (std::strcmp(arg, "--scrambled-halton") == 0) {
+        options.isInitializationQuasiRandom = true;
+      } else if (std::strcmp(arg, "--final-only") == 0) {
+        options.isFinalOnly = true;
+      } else if (std::strncmp(arg, "--", 2) == 0) {
+        return false;
+      } else {
+        positionalArgs.push_back(arg);
+      }
+    }
+
+    if (positionalArgs.size() != 2) {
+      return false;
+    }
+
+    options.instanceFilePath = positionalArgs[0];
+    options.resultFilePath = positionalArgs[1];
+
+    return true;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fputs(usage, stderr);
+    return EXIT_FAILURE;
+  }
+
+  bpt::ProblemInstance instance;
+  if (!bpt::readProblemInstance(options.instanceFilePath, instance)) {
+    std::fprintf(stderr,
+                 "bpt-run: cannot read problem instance file %s\n",
+                 options.instanceFilePath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // Files are checked when read, but a bad run could crash or take all the
+  // memory, so make sure.
+  if (!bpt::areGAParametersValid(instance.parameters)) {
+    std::fprintf(stderr,
+                 "bpt-run: invalid GA parameters in %s\n",
+                 options.instanceFilePath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  const bpt::Problem problem{
+    instance.inputBuildings,
+    instance.boundingArea,
+    instance.flowRates,
+    instance.floodProneAreas,
+    instance.landslideProneAreas,
+    instance.floodProneAreaPenalty,
+    instance.landslideProneAreaPenalty,
+    instance.buildingDistanceWeight,
+    instance.allowedOrientations
+  };
+
+  if (options.hasSeed) {
+    bpt::seedRandomEngine(options.seed);
+  }
+
+  bpt::GAEngine engine{ problem, instance.parameters };
+  bpt::GA& ga = engine.getGA();
+  ga.setFitnessCacheCapacity(options.fitnessCacheCapacity);
+  if (options.isSteadyState) {
+    ga.setReplacementType(bpt::ReplacementType::STEADY_STATE);
+  }
+
+  if (options.isCompact) {
+    ga.setGeneEncoding(bpt::GeneEncoding::COMPACT);
+  }
+
+  if (options.isMutationSelectionAdaptive) {
+    ga.setMutationSelectionType(bpt::MutationSelectionType::ADAPTIVE);
+  }
+
+  if (options.isPenalized) {
+    ga.setConstraintHandlingType(bpt::ConstraintHandlingType::PENALTY);
+  }
+
+  if (options.isInitializationQuasiRandom) {
+    ga.setInitializationType(bpt::InitializationType::SCRAMBLED_HALTON);
+  }
+
+  // The initial population counts as a generation.
+  const int numGenerations = instance.parameters.numGenerations;
+  const int numSolutionGenerations = options.isFinalOnly
+                                     ? 1
+                                     : numGenerations + 1;
+  bpt::RunResultWriter writer;
+  if (!writer.open(options.resultFilePath,
+                   instance.parameters,
+                   static_cast<int>(instance.inputBuildings.size()),
+                   numGenerations + 1,
+                   numSolutionGenerations)) {
+    std::fprintf(stderr,
+                 "bpt-run: cannot write run result file %s\n",
+                 options.resultFilePath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  engine.initialize();
+  while (true) {
+    const bool isLastGeneration =
+        engine.getNumGenerationsDone() == numGenerations;
+    if (!options.isFinalOnly || isLastGeneration) {
+      writer.writeGeneration(engine.getPopulation());
+    }
+
+    if (isLastGeneration) {
+      break;
+    }
+
+    engine.step(1);
+  }
+
+  engine.finish();
+
+  if (!writer.close(ga.getRecentRunAverageFitnesses(),
+                    ga.getRecentRunBestFitnesses(),
+                    ga.getRecentRunWorstFitnesses(),
+                    ga.getRecentRunFitnessCacheHitRates())) {
+    std::fprintf(stderr,
+                 "bpt-run: cannot write run result file %s\n",
+                 options.resultFilePath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+// Training workload for profile-guided optimization (see cmake/PGO.cmake).
+//
+// Runs the GA on a few synthetic instances that together exercise the hot
+// paths of typical runs: feasibility checks on sparse and dense sites,
+// hazard area lookups on a non-convex site, orientation tables, and the
+// optional initialization, replacement, encoding, mutation selection and
+// constraint handling modes. Every run is seeded, so that profiles are
+// reproducible.
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include <bpt/bpt.hpp>
+
+namespace
+{
+  struct TrainingInstance
+  {
+    eastl::vector<bpt::InputBuilding> inputBuildings;
+    cx::NPolygon boundingArea;
+    eastl::vector<cx::NPolygon> floodProneAreas;
+    eastl::vector<cx::NPolygon> landslideProneAreas;
+    eastl::vector<float> allowedOrientations;
+  };
+
+  cx::NPolygon createRectangle(const float minX,
+                               const float minY,
+                               const float maxX,
+                               const float maxY)
+  {
+    return cx::NPolygon{
+      { { minX, minY }, { maxX, minY }, { maxX, maxY }, { minX, maxY } }
+    };
+  }
+
+  eastl::vector<bpt::InputBuilding> createBuildings(const int numBuildings)
+  {
+    eastl::vector<bpt::InputBuilding> inputBuildings;
+    for (int i = 0; i < numBuildings; i++) {
+      // Vary the building sizes, so that both wide and narrow footprints
+      // show up.
+      inputBuildings.push_back(bpt::InputBuilding{
+        4.f + static_cast<float>(i % 5),
+        3.f + static_cast<float>((i * 3) % 4)
+      });
+    }
+
+    return inputBuildings;
+  }
+
+  eastl::vector<eastl::vector<float>> createFlowRates(const int numBuildings)
+  {
+    eastl::vector<eastl::vector<float>> flowRates(
+        numBuildings, eastl::vector<float>(numBuildings, 0.f));
+    for (int i = 0; i < numBuildings; i++) {
+      for (int j = 0; j < numBuildings; j++) {
+        if (i != j) {
+          flowRates[i][j] = static_cast<float>((i * 7 + j * 13) % 10);
+        }
+      }
+    }
+
+    return flowRates;
+  }
+
+  bpt::Problem createProblem(const TrainingInstance& instance)
+  {
+    const int numBuildings = static_cast<int>(instance.inputBuildings.size());
+    if (instance.allowedOrientations.empty()) {
+      return bpt::Problem{
+        instance.inputBuildings,
+        instance.boundingArea,
+        createFlowRates(numBuildings),
+        instance.floodProneAreas,
+        instance.landslideProneAreas,
+        100.f,
+        100.f,
+        1.f
+      };
+    }
+
+    return bpt::Problem{
+      instance.inputBuildings,
+      instance.boundingArea,
+      createFlowRates(numBuildings),
+      instance.floodProneAreas,
+      instance.landslideProneAreas,
+      100.f,
+      100.f,
+      1.f,
+      instance.allowedOrientations
+    };
+  }
+
+  // A large square site with few buildings.
+  TrainingInstance createSparseInstance()
+  {
+    return TrainingInstance{
+      createBuildings(8),
+      createRectangle(0.f, 0.f, 100.f, 100.f),
+      {},
+      {},
+      {}
+    };
+  }
+
+  // A small site that the buildings cover for the most part. Rejection
+  // sampling struggles here, so it is run with penalties instead.
+  TrainingInstance createDenseInstance()
+  {
+    return TrainingInstance{
+      createBuildings(10),
+      createRectangle(0.f, 0.f, 32.f, 32.f),
+      {},
+      {},
+      {}
+    };
+  }
+
+  // An L-shaped site with hazard areas and a fixed set of orientations.
+  TrainingInstance createHazardousInstance()
+  {
+    TrainingInstance instance;
+    instance.inputBuildings = createBuildings(14);
+    instance.boundingArea = cx::NPolygon{
+      {
+        { 0.f, 0.f }, { 120.f, 0.f }, { 120.f, 50.f },
+        { 50.f, 50.f }, { 50.f, 120.f }, { 0.f, 120.f }
+      }
+    };
+    for (int i = 0; i < 4; i++) {
+      const float offset = 25.f * static_cast<float>(i);
+      instance.floodProneAreas.push_back(
+          createRectangle(offset, 0.f, offset + 15.f, 20.f));
+      instance.landslideProneAreas.push_back(
+          createRectangle(0.f, offset + 5.f, 20.f, offset + 15.f));
+    }
+    instance.allowedOrientations = { 0.f, 45.f, 90.f, 135.f };
+
+    return instance;
+  }
+
+  bpt::GAParameters createParameters(const int populationSize,
+                                     const int numGenerations,
+                                     const bpt::SelectionType selectionType)
+  {
+    return bpt::GAParameters{
+      0.3f,
+      populationSize,
+      numGenerations,
+      4,
+      populationSize / 4,
+      false,
+      selectionType
+    };
+  }
+}
+
+int main()
+{
+  constexpr uint32_t seed = 0x42505400;
+
+  const bpt::Problem sparseProblem = createProblem(createSparseInstance());
+  const bpt::Problem denseProblem = createProblem(createDenseInstance());
+  const bpt::Problem hazardousProblem = createProblem(
+      createHazardousInstance());
+
+  // Default settings.
+  {
+    bpt::seedRandomEngine(seed);
+    bpt::GA ga;
+    ga.generateSolutions(
+        sparseProblem, createParameters(40, 150, bpt::SelectionType::TS));
+    ga.generateSolutions(
+        hazardousProblem, createParameters(40, 150, bpt::SelectionType::RWS));
+  }
+
+  // Steady-state replacement with the fitness cache, the compact encoding,
+  // local search and quasi-random initialization.
+  {
+    bpt::seedRandomEngine(seed + 1);
+    bpt::GA ga;
+    ga.setInitializationType(bpt::InitializationType::SCRAMBLED_HALTON);
+    ga.setFitnessCacheCapacity(4096);
+    ga.setReplacementType(bpt::ReplacementType::STEADY_STATE);
+    ga.setGeneEncoding(bpt::GeneEncoding::COMPACT);
+
+    bpt::GAParameters parameters = createParameters(
+        30, 100, bpt::SelectionType::TS);
+    parameters.isLocalSearchEnabled = true;
+    ga.generateSolutions(hazardousProblem, parameters);
+  }
+
+  // Adaptive mutation selection and penalty-based constraint handling.
+  {
+    bpt::seedRandomEngine(seed + 2);
+    bpt::GA ga;
+    ga.setFitnessCacheCapacity(4096);
+    ga.setMutationSelectionType(bpt::MutationSelectionType::ADAPTIVE);
+    ga.setConstraintHandlingType(bpt::ConstraintHandlingType::PENALTY);
+    ga.generateSolutions(
+        denseProblem, createParameters(40, 150, bpt::SelectionType::TS));
+  }
+
+  // Multi-objective runs.
+  {
+    bpt::seedRandomEngine(seed + 3);
+    bpt::GA ga;
+    ga.generateParetoFront(hazardousProblem, 0.3f, 40, 80);
+  }
+
+  return 0;
+}